@@ -0,0 +1,166 @@
+#include "allocTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <new>
+
+namespace BlockEater {
+
+namespace {
+
+const int ZONE_SLOTS = (int)ProfileZone::COUNT + 1;  // Last slot: outside every zone
+
+struct Counter {
+    std::atomic<long long> allocations;
+    std::atomic<long long> bytes;
+
+    void add(size_t size) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add((long long)size, std::memory_order_relaxed);
+    }
+    AllocCounts get() const {
+        return {allocations.load(std::memory_order_relaxed), bytes.load(std::memory_order_relaxed)};
+    }
+};
+
+Counter total;
+Counter zones[ZONE_SLOTS];
+
+// Open-addressed table keyed by return address; a slot's key is claimed
+// once with a CAS and never changes until resetSites()
+std::atomic<const void*> siteKeys[AllocTracker::MAX_SITES];
+Counter siteCounts[AllocTracker::MAX_SITES];
+
+void countSite(const void* caller, size_t size) {
+    uintptr_t hash = ((uintptr_t)caller >> 4) * 0x9E3779B97F4A7C15ull;
+    int start = (int)(hash % AllocTracker::MAX_SITES);
+    for (int probe = 0; probe < AllocTracker::MAX_SITES; probe++) {
+        int slot = (start + probe) % AllocTracker::MAX_SITES;
+        const void* key = siteKeys[slot].load(std::memory_order_acquire);
+        if (key == nullptr) {
+            if (siteKeys[slot].compare_exchange_strong(key, caller, std::memory_order_acq_rel)) {
+                key = caller;
+            }
+        }
+        if (key == caller) {
+            siteCounts[slot].add(size);
+            return;
+        }
+    }
+    // Table full: still in the totals
+}
+
+} // namespace
+
+bool AllocTracker::isEnabled() {
+#ifdef BLOCK_TRACK_ALLOC
+    return true;
+#else
+    return false;
+#endif
+}
+
+void AllocTracker::count(size_t size, const void* caller) {
+    total.add(size);
+    int zone = Profiler::getActiveZone();
+    zones[zone >= 0 ? zone : ZONE_SLOTS - 1].add(size);
+    countSite(caller, size);
+}
+
+AllocCounts AllocTracker::getTotal() {
+    return total.get();
+}
+
+AllocCounts AllocTracker::getZone(ProfileZone zone) {
+    return zones[(int)zone].get();
+}
+
+AllocCounts AllocTracker::getUnzoned() {
+    return zones[ZONE_SLOTS - 1].get();
+}
+
+int AllocTracker::getSites(AllocSite* out, int max) {
+    int n = 0;
+    for (int slot = 0; slot < MAX_SITES && n < max; slot++) {
+        const void* key = siteKeys[slot].load(std::memory_order_acquire);
+        if (key == nullptr) continue;
+        AllocCounts counts = siteCounts[slot].get();
+        out[n++] = {key, counts.allocations, counts.bytes};
+    }
+    std::sort(out, out + n, [](const AllocSite& a, const AllocSite& b) {
+        return a.allocations > b.allocations;
+    });
+    return n;
+}
+
+void AllocTracker::resetSites() {
+    for (int slot = 0; slot < MAX_SITES; slot++) {
+        siteKeys[slot].store(nullptr, std::memory_order_relaxed);
+        siteCounts[slot].allocations.store(0, std::memory_order_relaxed);
+        siteCounts[slot].bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+void AllocTracker::describeSite(const void* address, char* buffer, size_t size) {
+    Dl_info info;
+    if (!dladdr(address, &info) || !info.dli_sname) {
+        snprintf(buffer, size, "%p", address);
+        return;
+    }
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    const char* name = (status == 0 && demangled) ? demangled : info.dli_sname;
+    snprintf(buffer, size, "%s+0x%lx", name, (unsigned long)((const char*)address - (const char*)info.dli_saddr));
+    free(demangled);
+}
+
+} // namespace BlockEater
+
+#ifdef BLOCK_TRACK_ALLOC
+
+// Replacement global allocation functions. Array and nothrow forms report
+// their own caller; aligned forms keep the library default and go uncounted.
+namespace {
+
+void* trackedAlloc(size_t size, const void* caller) {
+    void* p = malloc(size ? size : 1);
+    if (p) {
+        BlockEater::AllocTracker::count(size, caller);
+    }
+    return p;
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    void* p = trackedAlloc(size, __builtin_return_address(0));
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    void* p = trackedAlloc(size, __builtin_return_address(0));
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size, __builtin_return_address(0));
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return trackedAlloc(size, __builtin_return_address(0));
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { free(p); }
+
+#endif // BLOCK_TRACK_ALLOC
@@ -0,0 +1,55 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include "profiler.h"
+#include <cstddef>
+
+namespace BlockEater {
+
+struct AllocCounts {
+    long long allocations;
+    long long bytes;
+};
+
+// One place that calls operator new: the return address of the call
+struct AllocSite {
+    const void* address;
+    long long allocations;
+    long long bytes;
+};
+
+// Heap accounting for finding and locking out per-frame allocations.
+// With BLOCK_TRACK_ALLOC the global operator new is replaced by one that
+// counts every allocation in total, per profiler zone of the allocating
+// thread (needs BLOCK_PROFILE, else everything is unzoned) and per call
+// site. Counting is a few relaxed atomics and never allocates itself.
+// Without BLOCK_TRACK_ALLOC every count stays zero. The game's replay
+// recording is reserved up front, so it only counts in frames of a run
+// longer than Replay::RESERVED_MINUTES.
+class AllocTracker {
+public:
+    static constexpr int MAX_SITES = 512;  // Distinct call sites kept, later ones only count in totals
+
+    static bool isEnabled();  // Built with BLOCK_TRACK_ALLOC
+
+    // Running totals since startup; diff two readings for a frame or tick
+    static AllocCounts getTotal();
+    static AllocCounts getZone(ProfileZone zone);
+    static AllocCounts getUnzoned();
+
+    // Call sites seen since the last resetSites(), most allocations first
+    static int getSites(AllocSite* out, int max);
+    static void resetSites();  // While nothing else allocates
+    // Symbol + offset of a call site, for reports (may allocate)
+    static void describeSite(const void* address, char* buffer, size_t size);
+
+    static void count(size_t size, const void* caller);  // Called by the operator new hook
+};
+
+inline AllocCounts operator-(const AllocCounts& a, const AllocCounts& b) {
+    return {a.allocations - b.allocations, a.bytes - b.bytes};
+}
+
+} // namespace BlockEater
+
+#endif // ALLOC_TRACKER_H
@@ -1,4 +1,5 @@
 #include "assets.h"
+#include "random.h"
 #include <cmath>
 #include <cstdlib>
 
@@ -179,16 +180,18 @@ Texture2D AssetManager::GeneratePixelBackground() {
     }
 
     // Add random stars with varying brightness and twinkling effect
+    // (fixed seed, the sky looks the same every launch)
+    Random random(0, RandomStream::ASSETS);
     const int numStars = 200;
     for (int i = 0; i < numStars; i++) {
-        int x = rand() % width;
-        int y = rand() % height;
-        int starSize = 1 + (rand() % 2);  // 1-2 pixels
-        int brightness = 150 + (rand() % 106);  // 150-255
+        int x = random.nextInt(width);
+        int y = random.nextInt(height);
+        int starSize = 1 + random.nextInt(2);  // 1-2 pixels
+        int brightness = 150 + random.nextInt(106);  // 150-255
 
         // Add twinkling effect: some stars are brighter for variation
-        if (rand() % 3 == 0) {
-            brightness = 200 + (rand() % 56);  // Extra bright twinkling stars
+        if (random.nextInt(3) == 0) {
+            brightness = 200 + random.nextInt(56);  // Extra bright twinkling stars
         }
 
         for (int dy = 0; dy < starSize && y + dy < height; dy++) {
@@ -205,8 +208,8 @@ Texture2D AssetManager::GeneratePixelBackground() {
     // Add a few brighter "stars" with slight blue tint
     const int numBrightStars = 20;
     for (int i = 0; i < numBrightStars; i++) {
-        int x = rand() % width;
-        int y = rand() % height;
+        int x = random.nextInt(width);
+        int y = random.nextInt(height);
 
         int index = (y * width + x) * 4;
         ((unsigned char*)img.data)[index] = 200;      // R
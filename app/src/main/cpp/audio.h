@@ -29,9 +29,11 @@ public:
     static Sound GenerateRotateSound();
     static Music GenerateBackgroundMusic();
 
-private:
+    // Fills up to size samples of a 44.1 kHz mono wave (public for block_bench)
     static void GenerateWave(short* buffer, int size, int frequency, float duration,
                            WaveType type, float volume = 1.0f);
+
+private:
     static void ApplyEnvelope(short* buffer, int size, float attack, float decay, float sustain, float release);
 };
 
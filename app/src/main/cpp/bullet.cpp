@@ -1,67 +1,124 @@
 #include "bullet.h"
+#include "enemy.h"
+#include "spatial.h"
+#include "collision.h"
+#include "integrator.h"
 #include <cmath>
 
 namespace BlockEater {
 
-Bullet::Bullet(Vector2 pos, Vector2 dir, int dmg, int id)
-    : position(pos)
-    , velocity{0, 0}
-    , size(10)
-    , damage(dmg)
-    , playerId(id)
-    , lifetime(3.0f)  // 3 seconds max lifetime
-    , alive(true)
-    , color{255, 255, 0, 255}  // Yellow
+BulletPool::BulletPool()
+    : used(0)
 {
+}
+
+BulletPool::~BulletPool() {
+}
+
+int BulletPool::spawn(Vector2 pos, Vector2 dir, int dmg, int id) {
+    if (used == CAPACITY) return -1;
+
+    int row = used++;
+    position[row] = pos;
+    previousPosition[row] = pos;
+    velocity[row] = {0, 0};
+    lifetime[row] = LIFETIME;
+    damage[row] = dmg;
+    playerId[row] = id;
+    alive[row] = 1;
+
     // Normalize direction and set velocity
     float len = sqrtf(dir.x * dir.x + dir.y * dir.y);
     if (len > 0.001f) {
-        velocity.x = (dir.x / len) * 400.0f;  // Bullet speed
-        velocity.y = (dir.y / len) * 400.0f;
+        velocity[row].x = (dir.x / len) * SPEED;
+        velocity[row].y = (dir.y / len) * SPEED;
     }
+    return row;
 }
 
-Bullet::~Bullet() {
+void BulletPool::clear() {
+    used = 0;
 }
 
-void Bullet::update(float dt) {
-    if (!alive) return;
+void BulletPool::swapRemove(int row) {
+    int last = --used;
+    if (row == last) return;
+    position[row] = position[last];
+    previousPosition[row] = previousPosition[last];
+    velocity[row] = velocity[last];
+    lifetime[row] = lifetime[last];
+    damage[row] = damage[last];
+    playerId[row] = playerId[last];
+    alive[row] = alive[last];
+}
 
-    // Move bullet
-    position.x += velocity.x * dt;
-    position.y += velocity.y * dt;
+void BulletPool::update(float dt, SpatialHash& enemyGrid, Vector2 playerPos, float playerHalf,
+                        std::vector<BulletHit>& hits) {
+    hits.clear();
+    const float half = SIZE / 2.0f;
 
-    // Decrease lifetime
-    lifetime -= dt;
-    if (lifetime <= 0) {
-        alive = false;
-        return;
-    }
+    // Integrate every row up front with the vector kernel (rows killed
+    // since the last pass move too, they're dropped below anyway)
+    advanceBodies(position, previousPosition, velocity, lifetime, used, dt);
+
+    int i = 0;
+    while (i < used) {
+        // Killed since the last pass (eaten by a STATIONARY enemy)
+        if (!alive[i]) {
+            swapRemove(i);
+            continue;
+        }
+
+        // Swept segment of this tick's move
+        Vector2 from = previousPosition[i];
+        Vector2 to = position[i];
+
+        // Check lifetime and world bounds
+        if (lifetime[i] <= 0 ||
+            to.x < 0 || to.x > WORLD_WIDTH || to.y < 0 || to.y > WORLD_HEIGHT) {
+            swapRemove(i);
+            continue;
+        }
+
+        if (playerId[i] >= 0) {
+            // Player bullet: earliest enemy along this tick's motion
+            SweepHit hit;
+            if (enemyGrid.querySegment(from, to, half, nullptr, &hit, 1) > 0) {
+                Vector2 point = {from.x + (to.x - from.x) * hit.time,
+                                 from.y + (to.y - from.y) * hit.time};
+                hit.enemy->takeDamage(damage[i]);
+                hits.push_back({hit.enemy, damage[i], point, !hit.enemy->isAlive()});
+                swapRemove(i);
+                continue;
+            }
+        } else {
+            // Enemy bullet: against the player
+            Vector2 delta = to - from;
+            float toi;
+            if (sweepAABB(from, delta, half, playerPos, playerHalf, toi)) {
+                hits.push_back({nullptr, damage[i], from + delta * toi, false});
+                swapRemove(i);
+                continue;
+            }
+        }
 
-    // Check world bounds
-    if (position.x < 0 || position.x > WORLD_WIDTH ||
-        position.y < 0 || position.y > WORLD_HEIGHT) {
-        alive = false;
+        i++;
     }
 }
 
-void Bullet::draw() {
-    if (!alive) return;
-
-    // Draw bullet with glow effect
-    DrawCircle((int)position.x, (int)position.y, size, {255, 255, 100, 150});  // Outer glow
-    DrawCircle((int)position.x, (int)position.y, size - 2, color);  // Core
-
-    // Draw trail
-    for (int i = 1; i <= 3; i++) {
-        float trailAlpha = 100 - i * 30;
-        float trailSize = size - i * 2;
-        Vector2 trailPos = {
-            position.x - velocity.x * 0.01f * i,
-            position.y - velocity.y * 0.01f * i
-        };
-        DrawCircle((int)trailPos.x, (int)trailPos.y, (int)trailSize, {255, 255, 0, (unsigned char)trailAlpha});
+int BulletPool::getSprites(Rectangle area, std::vector<BulletSprite>& out) const {
+    out.clear();
+    int culled = 0;
+    for (int i = 0; i < used; i++) {
+        if (!alive[i]) continue;
+        Vector2 p = position[i];
+        if (p.x < area.x || p.x > area.x + area.width || p.y < area.y || p.y > area.y + area.height) {
+            culled++;
+            continue;
+        }
+        out.push_back({previousPosition[i], position[i], velocity[i]});
     }
+    return culled;
 }
 
 } // namespace BlockEater
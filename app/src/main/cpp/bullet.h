@@ -3,34 +3,75 @@
 
 #include "raylib.h"
 #include "game.h"
+#include <vector>
 
 namespace BlockEater {
 
-class Bullet {
+class Enemy;
+class SpatialHash;
+
+// One bullet hit found by BulletPool::update
+struct BulletHit {
+    Enemy* enemy;     // Enemy that was hit, nullptr when the player was hit
+    int damage;
+    Vector2 point;    // Impact point along the bullet's motion
+    bool killed;      // Enemy died from this hit (damage is already applied)
+};
+
+// What the renderer needs to draw one bullet
+struct BulletSprite {
+    Vector2 from;  // Position at the start of the tick
+    Vector2 to;    // Position at the end of the tick
+    Vector2 velocity;
+
+    void draw(float alpha) const;  // alpha blends from -> to
+};
+
+// Fixed-capacity bullet storage, one column per component.
+// Rows [0, count()) are in use and stay dense: expired and dead bullets are
+// swap-removed by update(), so a row index is only stable until the next
+// update() or clear(). Nothing allocates after construction.
+class BulletPool {
 public:
-    Bullet(Vector2 pos, Vector2 dir, int damage, int playerId);
-    ~Bullet();
+    static constexpr int CAPACITY = 2048;
+    static constexpr int SIZE = 10;           // Every bullet has the same size
+    static constexpr float SPEED = 400.0f;
+    static constexpr float LIFETIME = 3.0f;   // 3 seconds max lifetime
+
+    BulletPool();
+    ~BulletPool();
+
+    // Returns the new row, or -1 when the pool is full (the shot is dropped)
+    int spawn(Vector2 pos, Vector2 dir, int damage, int playerId);
+    void kill(int row) { alive[row] = 0; }
+    void clear();
 
-    void update(float dt);
-    void draw();
+    // Fused per-tick pass: integrate, expire by lifetime and world bounds,
+    // then test player bullets against the enemy grid and enemy bullets
+    // against the player, both swept over this tick's motion. Enemy damage
+    // is applied immediately so later bullets pass through dead enemies;
+    // the player's damage and all effects are left to the caller.
+    void update(float dt, SpatialHash& enemyGrid, Vector2 playerPos, float playerHalf,
+                std::vector<BulletHit>& hits);
+    // Live rows centred inside area, replaces out; returns the live rows left out
+    int getSprites(Rectangle area, std::vector<BulletSprite>& out) const;
 
-    bool isAlive() const { return alive; }
-    Vector2 getPosition() const { return position; }
-    int getSize() const { return size; }
-    int getDamage() const { return damage; }
-    int getPlayerId() const { return playerId; }
+    int count() const { return used; }
+    bool isAlive(int row) const { return alive[row] != 0; }
 
-    void kill() { alive = false; }
+    // Columns
+    Vector2 position[CAPACITY];
+    Vector2 previousPosition[CAPACITY];  // Start of the last move (for swept tests)
+    Vector2 velocity[CAPACITY];
+    float lifetime[CAPACITY];
+    int damage[CAPACITY];
+    int playerId[CAPACITY];              // >= 0 player bullet, < 0 enemy bullet
+    unsigned char alive[CAPACITY];
 
 private:
-    Vector2 position;
-    Vector2 velocity;
-    int size;
-    int damage;
-    int playerId;
-    float lifetime;
-    bool alive;
-    Color color;
+    int used;
+
+    void swapRemove(int row);
 };
 
 } // namespace BlockEater
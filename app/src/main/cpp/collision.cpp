@@ -0,0 +1,205 @@
+#include "collision.h"
+#include "enemy.h"
+#include "simd.h"
+#include "jobs.h"
+#include <algorithm>
+#include <cmath>
+
+namespace BlockEater {
+
+ContactClass classifyPair(EnemyType a, EnemyType b) {
+    if (a == EnemyType::BOUNCING || b == EnemyType::BOUNCING) {
+        return ContactClass::BOUNCING;
+    }
+    if (a == EnemyType::STATIONARY || b == EnemyType::STATIONARY) {
+        return ContactClass::FOOD;
+    }
+    return ContactClass::MOBILE;
+}
+
+bool sweepAABB(Vector2 from, Vector2 delta, float halfA, Vector2 center, float halfB, float& toi) {
+    // Ray from 'from' against the Minkowski sum of both boxes (slab test)
+    float extent = halfA + halfB;
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+
+    float start[2] = {from.x - center.x, from.y - center.y};
+    float dir[2] = {delta.x, delta.y};
+
+    for (int axis = 0; axis < 2; axis++) {
+        if (fabsf(dir[axis]) < 1e-6f) {
+            // Not moving on this axis: must already be inside the slab
+            if (fabsf(start[axis]) >= extent) return false;
+            continue;
+        }
+
+        float t1 = (-extent - start[axis]) / dir[axis];
+        float t2 = (extent - start[axis]) / dir[axis];
+        if (t1 > t2) {
+            float tmp = t1;
+            t1 = t2;
+            t2 = tmp;
+        }
+        if (t1 > tEnter) tEnter = t1;
+        if (t2 < tExit) tExit = t2;
+
+        // Touching edges doesn't count, same as the discrete overlap tests
+        if (tEnter >= tExit) return false;
+    }
+
+    toi = tEnter;
+    return true;
+}
+
+void OverlapBatch::clear() {
+    ax.clear();
+    ay.clear();
+    bx.clear();
+    by.clear();
+    extent.clear();
+    hits.clear();
+}
+
+void OverlapBatch::reserve(int rows) {
+    ax.reserve(rows);
+    ay.reserve(rows);
+    bx.reserve(rows);
+    by.reserve(rows);
+    extent.reserve(rows);
+    hits.reserve(rows);
+}
+
+void OverlapBatch::add(Vector2 a, Vector2 b, float combinedHalfSize) {
+    ax.push_back(a.x);
+    ay.push_back(a.y);
+    bx.push_back(b.x);
+    by.push_back(b.y);
+    extent.push_back(combinedHalfSize);
+}
+
+int testOverlaps(OverlapBatch& batch) {
+    int n = batch.count();
+    batch.hits.resize(n);
+    int* out = batch.hits.data();
+    int hitCount = 0;
+    int i = 0;
+
+#ifdef BLOCK_SIMD
+    using namespace simd;
+    const float* ax = batch.ax.data();
+    const float* ay = batch.ay.data();
+    const float* bx = batch.bx.data();
+    const float* by = batch.by.data();
+    const float* ext = batch.extent.data();
+    for (; i + LANES <= n; i += LANES) {
+        VFloat e = vload(ext + i);
+        VMask overlapX = vlt(vabs(vsub(vload(ax + i), vload(bx + i))), e);
+        VMask overlapY = vlt(vabs(vsub(vload(ay + i), vload(by + i))), e);
+        int mask = vmovemask(vand(overlapX, overlapY));
+
+        // Branchless compaction: always write, only advance on a hit
+        for (int k = 0; k < LANES; k++) {
+            out[hitCount] = i + k;
+            hitCount += (mask >> k) & 1;
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        float dx = fabsf(batch.ax[i] - batch.bx[i]);
+        float dy = fabsf(batch.ay[i] - batch.by[i]);
+        out[hitCount] = i;
+        hitCount += (dx < batch.extent[i] && dy < batch.extent[i]) ? 1 : 0;
+    }
+
+    batch.hits.resize(hitCount);
+    return hitCount;
+}
+
+void buildEnemyContacts(const std::vector<EnemyPair>& pairs, OverlapBatch& batch,
+                        std::vector<Contact>& out) {
+    out.clear();
+
+    // Pack every candidate pair, row i is pairs[i]
+    batch.clear();
+    for (const EnemyPair& pair : pairs) {
+        batch.add(pair.a->getPosition(), pair.b->getPosition(),
+                  (pair.a->getSize() + pair.b->getSize()) / 2.0f);
+    }
+
+    // AABB overlap decides whether the pair is in contact
+    testOverlaps(batch);
+
+    for (int row : batch.hits) {
+        Enemy* e1 = pairs[row].a;
+        Enemy* e2 = pairs[row].b;
+        if (!e1->isAlive() || !e2->isAlive()) continue;
+        // Far from the player, enemies pass through each other
+        if (e1->getLodTier() == LodTier::AGGREGATE && e2->getLodTier() == LodTier::AGGREGATE) continue;
+
+        Contact contact;
+        contact.a = e1;
+        contact.b = e2;
+        contact.normal = {0, 0};
+        contact.penetration = 0;
+        contact.pairClass = classifyPair(e1->getType(), e2->getType());
+
+        float dx = batch.ax[row] - batch.bx[row];
+        float dy = batch.ay[row] - batch.by[row];
+        float dist = sqrtf(dx * dx + dy * dy);
+        if (dist >= 0.001f) {
+            contact.normal = {dx / dist, dy / dist};
+            if (dist < batch.extent[row]) {
+                contact.penetration = batch.extent[row] - dist;
+            }
+        }
+
+        out.push_back(contact);
+    }
+}
+
+void reserveEnemyContacts(int enemies, std::vector<ContactStripe>& stripes, std::vector<Contact>& out) {
+    int share = (enemies + CONTACT_STRIPE_COUNT - 1) / CONTACT_STRIPE_COUNT;
+    int pairs = std::max(CONTACT_STRIPE_PAIRS, share * CONTACT_PAIRS_PER_ENEMY);
+    int contacts = std::max(CONTACT_STRIPE_CONTACTS, share * CONTACT_CONTACTS_PER_ENEMY);
+    if ((int)stripes.size() < CONTACT_STRIPE_COUNT) {
+        stripes.resize(CONTACT_STRIPE_COUNT);
+    }
+    for (ContactStripe& stripe : stripes) {
+        stripe.pairs.reserve(pairs);
+        stripe.batch.reserve(pairs);
+        stripe.contacts.reserve(contacts);
+    }
+    out.reserve(CONTACT_STRIPE_COUNT * contacts);
+}
+
+void findEnemyContacts(const SpatialHash& grid, JobSystem& jobs,
+                       std::vector<ContactStripe>& stripes, std::vector<Contact>& out) {
+    const int stripeCount = CONTACT_STRIPE_COUNT;
+    if ((int)stripes.size() < stripeCount) {
+        reserveEnemyContacts(0, stripes, out);
+    }
+
+    jobs.parallelFor(stripeCount, 1, [&](int begin, int end, int) {
+        for (int s = begin; s < end; s++) {
+            int firstRow = s * CONTACT_STRIPE_ROWS;
+            int endRow = std::min(firstRow + CONTACT_STRIPE_ROWS, SpatialHash::GRID_ROWS);
+            ContactStripe& stripe = stripes[s];
+            grid.queryPairs(firstRow, endRow, stripe.pairs);
+            buildEnemyContacts(stripe.pairs, stripe.batch, stripe.contacts);
+        }
+    });
+
+    // Merge in stripe order, then sort on ids: the result no longer depends
+    // on how pairs were spread over stripes or threads
+    out.clear();
+    for (int s = 0; s < stripeCount; s++) {
+        out.insert(out.end(), stripes[s].contacts.begin(), stripes[s].contacts.end());
+    }
+    std::sort(out.begin(), out.end(), [](const Contact& x, const Contact& y) {
+        if (x.a->getId() != y.a->getId()) return x.a->getId() < y.a->getId();
+        return x.b->getId() < y.b->getId();
+    });
+}
+
+} // namespace BlockEater
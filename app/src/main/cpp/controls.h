@@ -3,6 +3,7 @@
 
 #include "raylib.h"
 #include "game.h"
+#include "spsc.h"
 
 namespace BlockEater {
 
@@ -18,6 +19,20 @@ struct VirtualJoystick {
     VirtualJoystick() : origin{0, 0}, radius(120), input{0, 0}, active(false), originSet(false), touchPointId(-1) {}
 };
 
+// One frame of gameplay input, handed from the render thread to the
+// simulation thread. Ticks apply the commands stamped before they end.
+struct InputCommand {
+    double time;     // Sim clock when the frame sampled it
+    Vector2 move;    // Joystick / keyboard direction
+    int skill;       // SkillType to activate, -1 for none
+    bool quickSave;
+    Rectangle view;  // World area the camera showed, for snapshot culling
+};
+
+static constexpr size_t INPUT_QUEUE_CAPACITY = 256;  // Over 4 s of frames at 60 FPS
+
+class InputQueue : public SpscQueue<InputCommand, INPUT_QUEUE_CAPACITY> {};
+
 class ControlSystem {
 public:
     ControlSystem();
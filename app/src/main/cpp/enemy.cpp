@@ -1,17 +1,23 @@
 #include "enemy.h"
 #include "bullet.h"
-#include <cstdlib>
+#include "spatial.h"
+#include "collision.h"
 #include <cmath>
 
 namespace BlockEater {
 
-Enemy::Enemy(EnemyType t, Vector2 pos, int startSize)
-    : position(pos)
-    , velocity{0, 0}
-    , acceleration{0, 0}
-    , size(startSize)
+Enemy::Enemy(EnemyStore& owner, EnemyType t, Vector2 pos, int startSize)
+    : store(&owner)
+    , table(&owner.table(t))
+    , row(owner.attach(*table, this, pos, startSize))
+    , id(owner.nextId++)
+    , random(owner.random.split(id))
+    , maxHealth(0)
     , type(t)
-    , alive(true)
+    , gridProxy(-1)
+    , lodTier(LodTier::FULL)
+    , lodTime(0)
+    , heldAcceleration({0, 0})
     , chasingState(ChasingState::CHASING)
     , blockedTimer(0)
     , vulnerableTimer(0)
@@ -23,9 +29,9 @@ Enemy::Enemy(EnemyType t, Vector2 pos, int startSize)
 
     // Give random initial velocity for bouncing and floating enemies
     if (type == EnemyType::BOUNCING || type == EnemyType::FLOATING) {
-        float angle = ((float)(rand() % 360)) * DEG2RAD;
-        velocity.x = cosf(angle) * speed * 0.5f;
-        velocity.y = sinf(angle) * speed * 0.5f;
+        float angle = (float)random.nextInt(360) * DEG2RAD;
+        velocity().x = cosf(angle) * speed * 0.5f;
+        velocity().y = sinf(angle) * speed * 0.5f;
     }
 }
 
@@ -34,48 +40,79 @@ Enemy::~Enemy() {
 
 void Enemy::updateStatsForSize() {
     // Mass proportional to volume (size^3)
-    mass = (float)(size * size * size) / 1000.0f;
-    if (mass < 1.0f) mass = 1.0f;
+    mass() = (float)(size() * size() * size()) / 1000.0f;
+    if (mass() < 1.0f) mass() = 1.0f;
     
     // Set stats based on size
-    maxHealth = size * 2;
-    if (health == 0) health = maxHealth;
+    maxHealth = size() * 2;
+    if (health() == 0) health() = maxHealth;
     
     // Set color and speed based on type
     switch (type) {
         case EnemyType::FLOATING:
             color = {255, 100, 100, 255};  // Red
             speed = 50.0f;
-            expValue = size / 2;
+            expValue = size() / 2;
             break;
         case EnemyType::CHASING:
             color = {255, 50, 50, 255};    // Dark Red
             speed = 80.0f;
-            expValue = size;
+            expValue = size();
             break;
         case EnemyType::STATIONARY:
             color = {100, 255, 100, 255};  // Green
             speed = 0.0f;
-            expValue = size / 3;
+            expValue = size() / 3;
             break;
         case EnemyType::BOUNCING:
             color = {255, 150, 50, 255};   // Orange
             speed = 120.0f;
-            expValue = size / 2 + 10;
+            expValue = size() / 2 + 10;
             break;
     }
 }
 
-void Enemy::update(float dt, Vector2 playerPos, std::vector<Bullet*>& bullets, 
-                   const std::vector<Enemy*>& allEnemies) {
-    if (!alive) return;
+void Enemy::simulate(unsigned int tick, float dt, Vector2 playerPos, const BulletPool& bullets,
+                     const SpatialHash& grid, const BulletGrid& bulletGrid,
+                     EnemyCommandBuffer& commands) {
+    int period = 1;
+    if (lodTier == LodTier::REDUCED) period = EnemyStore::LOD_REDUCED_PERIOD;
+    if (lodTier == LodTier::AGGREGATE) period = EnemyStore::LOD_AGGREGATE_PERIOD;
+
+    lodTime += dt;
+
+    // Staggered by id, so each tick updates a slice of the far enemies
+    if ((tick + id) % period != 0) {
+        if (!isAsleep()) {
+            acceleration().x += heldAcceleration.x;
+            acceleration().y += heldAcceleration.y;
+        }
+        return;
+    }
+
+    // One coarse step covering every tick since the last update; timers
+    // carry over, so changing tier never skips or repeats time
+    Vector2 before = acceleration();
+    update(lodTime, playerPos, bullets, grid, bulletGrid, commands);
+    lodTime = 0;
+    if (period > 1 && !isAsleep()) {
+        heldAcceleration = {acceleration().x - before.x, acceleration().y - before.y};
+    } else {
+        heldAcceleration = {0, 0};
+    }
+}
+
+void Enemy::update(float dt, Vector2 playerPos, const BulletPool& bullets,
+                   const SpatialHash& grid, const BulletGrid& bulletGrid,
+                   EnemyCommandBuffer& commands) {
+    if (!alive()) return;
 
     // Update AI state
     if (type == EnemyType::CHASING) {
-        checkIfBlocked(allEnemies);
+        checkIfBlocked(grid);
         
         // Check vulnerable state (health < 30%)
-        if ((float)health / maxHealth < 0.3f) {
+        if ((float)health() / maxHealth < 0.3f) {
             chasingState = ChasingState::VULNERABLE;
         } else if (chasingState == ChasingState::VULNERABLE && blockedTimer <= 0) {
             chasingState = ChasingState::CHASING;
@@ -96,77 +133,67 @@ void Enemy::update(float dt, Vector2 playerPos, std::vector<Bullet*>& bullets,
     // Update based on type and state
     if (type == EnemyType::CHASING && chasingState == ChasingState::BLOCKED) {
         // Temporarily act like FLOATING when blocked
-        updateFloating(dt);
+        updateFloating();
     } else {
         switch (type) {
             case EnemyType::FLOATING:
-                updateFloating(dt);
-                tryShootBullet(bullets);
+                updateFloating();
+                // Far shots expire long before they could reach the player
+                if (lodTier != LodTier::AGGREGATE) {
+                    tryShootBullet(commands, dt);
+                }
                 break;
             case EnemyType::CHASING:
-                updateChasing(dt, playerPos);
+                updateChasing(playerPos);
                 break;
-            case EnemyType::STATIONARY:
-                updateStationary(dt);
-                tryEatBullet(bullets);
+            case EnemyType::STATIONARY: {
+                updateStationary();
+                int row = findEdibleBullet(bullets, bulletGrid);
+                if (row >= 0) {
+                    commands.eats.push_back({this, row});
+                }
                 break;
+            }
             case EnemyType::BOUNCING:
-                updateBouncing(dt);
+                // No AI: the per-tick integration moves it and
+                // EnemyStore::clampToWorld reflects it off the walls, so
+                // an update every few ticks (LOD) moves it the same way
                 break;
         }
     }
     
-    // Apply physics
-    updatePhysics(dt);
-    checkBounds();
-}
-
-void Enemy::updatePhysics(float dt) {
-    // Apply acceleration to velocity
-    velocity.x += acceleration.x * dt;
-    velocity.y += acceleration.y * dt;
-    
-    // Apply friction
-    velocity = velocity * FRICTION;
-    
-    // Update position
-    position.x += velocity.x * dt;
-    position.y += velocity.y * dt;
-    
-    // Reset acceleration
-    acceleration = {0, 0};
 }
 
 void Enemy::applyForce(Vector2 force) {
+    wake();
     // F = ma, so a = F/m
-    acceleration.x += force.x / mass;
-    acceleration.y += force.y / mass;
+    acceleration().x += force.x / mass();
+    acceleration().y += force.y / mass();
 }
 
-void Enemy::applyRigidBodyCollision(Enemy* other) {
+void Enemy::applyRigidBodyCollision(Enemy* other, Vector2 normal, float penetration) {
     if (!other || !other->isAlive() || other == this) return;
     
-    Vector2 pos1 = position;
+    // Coincident centers have no usable normal
+    if (normal.x == 0 && normal.y == 0) return;
+    
+    // A push wakes both sides
+    wake();
+    other->wake();
+    
     Vector2 pos2 = other->getPosition();
-    Vector2 vel1 = velocity;
+    Vector2 vel1 = velocity();
     Vector2 vel2 = other->getVelocity();
-    float m1 = mass;
+    float m1 = mass();
     float m2 = other->getMass();
     
-    // Calculate collision normal
-    Vector2 normal = {pos1.x - pos2.x, pos1.y - pos2.y};
-    float dist = Vector2Length(normal);
-    if (dist < 0.001f) return;
-    normal = Vector2Normalize(normal);
-    
-    // Separate overlapping entities
-    float combinedRadius = (size + other->getSize()) / 2.0f;
-    if (dist < combinedRadius) {
-        float overlap = combinedRadius - dist;
+    // Separate overlapping entities (normal and penetration come from the contact)
+    if (penetration > 0) {
+        float overlap = penetration;
         float sep1 = overlap * (m2 / (m1 + m2));
         float sep2 = overlap * (m1 / (m1 + m2));
-        position.x += normal.x * sep1;
-        position.y += normal.y * sep1;
+        position().x += normal.x * sep1;
+        position().y += normal.y * sep1;
         other->setPosition({pos2.x - normal.x * sep2, pos2.y - normal.y * sep2});
     }
     
@@ -179,8 +206,8 @@ void Enemy::applyRigidBodyCollision(Enemy* other) {
     float v2nNew = (v2n * (m2 - m1) + 2 * m1 * v1n) / (m1 + m2);
     
     // Update velocities
-    velocity.x += (v1nNew - v1n) * normal.x;
-    velocity.y += (v1nNew - v1n) * normal.y;
+    velocity().x += (v1nNew - v1n) * normal.x;
+    velocity().y += (v1nNew - v1n) * normal.y;
     other->setVelocity({vel2.x + (v2nNew - v2n) * normal.x, 
                         vel2.y + (v2nNew - v2n) * normal.y});
 }
@@ -188,9 +215,10 @@ void Enemy::applyRigidBodyCollision(Enemy* other) {
 void Enemy::applyRigidBodyCollision(float otherMass, Vector2 otherVelocity, 
                                      Vector2 collisionNormal) {
     // Elastic collision with player or other entity
-    Vector2 vel1 = velocity;
+    wake();
+    Vector2 vel1 = velocity();
     Vector2 vel2 = otherVelocity;
-    float m1 = mass;
+    float m1 = mass();
     float m2 = otherMass;
     Vector2 n = collisionNormal;
     
@@ -210,36 +238,42 @@ void Enemy::applyRigidBodyCollision(float otherMass, Vector2 otherVelocity,
     
     // Apply impulse
     Vector2 impulse = {j * n.x, j * n.y};
-    velocity.x += impulse.x / m1;
-    velocity.y += impulse.y / m1;
+    velocity().x += impulse.x / m1;
+    velocity().y += impulse.y / m1;
 }
 
 void Enemy::applyBouncingDamage(Enemy* other) {
     if (!other || type != EnemyType::BOUNCING) return;
     
     // BOUNCING enemies deal massive damage and push others away
-    int damage = (int)(size * 2);  // Massive damage
+    int damage = (int)(size() * 2);  // Massive damage
     other->takeDamage(damage);
     
     // Push other away strongly
-    Vector2 pushDir = Vector2Normalize(other->getPosition() - position);
-    float pushForce = mass * 500.0f;  // Strong push
+    Vector2 pushDir = Vector2Normalize(other->getPosition() - position());
+    float pushForce = mass() * 500.0f;  // Strong push
     other->applyForce({pushDir.x * pushForce, pushDir.y * pushForce});
 }
 
-void Enemy::checkIfBlocked(const std::vector<Enemy*>& allEnemies) {
+void Enemy::checkIfBlocked(const SpatialHash& grid) {
     if (type != EnemyType::CHASING) return;
     
-    // Check if path to player is blocked by other enemies
-    int blockCount = 0;
-    Vector2 toPlayer = {0, 0};  // Will be set in updateChasing
+    // Check if path to player is blocked by other enemies.
+    // Only nearby enemies can block, so ask the grid for the closest few
+    // (padded by the largest enemy since the threshold uses both sizes).
+    Enemy* neighbors[MAX_BLOCK_NEIGHBORS];
+    float searchRadius = (float)(size() + grid.getMaxEnemySize());
+    Vector2 center = getPreviousPosition();
+    int count = grid.queryNeighbors(center, searchRadius, this, neighbors, MAX_BLOCK_NEIGHBORS);
     
-    for (auto* enemy : allEnemies) {
-        if (!enemy->isAlive() || enemy == this) continue;
+    int blockCount = 0;
+    for (int i = 0; i < count; i++) {
+        Enemy* enemy = neighbors[i];
         
         // Simple check: if other enemy is very close, consider blocked
-        float dist = Vector2Length(position - enemy->getPosition());
-        if (dist < (size + enemy->getSize())) {
+        Vector2 d = center - enemy->getPreviousPosition();
+        float reach = (float)(size() + enemy->getSize());
+        if (d.x * d.x + d.y * d.y < reach * reach) {
             blockCount++;
         }
     }
@@ -253,95 +287,50 @@ void Enemy::checkIfBlocked(const std::vector<Enemy*>& allEnemies) {
 
 bool Enemy::isVulnerable() const {
     if (type != EnemyType::CHASING && type != EnemyType::FLOATING) return false;
-    return (float)health / maxHealth < 0.3f;
+    return (float)getHealth() / maxHealth < 0.3f;
 }
 
-void Enemy::draw() {
-    if (!alive) return;
+EnemySprite Enemy::getSprite(float simTime) const {
+    EnemySprite sprite;
+    sprite.from = table->previousPosition[row];
+    sprite.to = table->position[row];
+
+    // Slight bobbing motion for STATIONARY
+    if (type == EnemyType::STATIONARY) {
+        float bob = -0.25f * cosf(simTime * 2.0f);
+        sprite.from.y += bob;
+        sprite.to.y += bob;
+    }
+    sprite.size = getSize();
+    sprite.color = color;
 
-    Color drawColor = color;
-    
     // Visual indicator for vulnerable state
     if (isVulnerable()) {
-        drawColor = {200, 100, 100, 200};  // Darker, semi-transparent
+        sprite.color = {200, 100, 100, 200};  // Darker, semi-transparent
     }
     // Visual indicator for blocked state
     if (blockedTimer > 0 && type == EnemyType::CHASING) {
-        drawColor = {150, 150, 255, 255};  // Blue tint when blocked
+        sprite.color = {150, 150, 255, 255};  // Blue tint when blocked
     }
 
-    // Draw shadow
-    DrawRectangle(
-        (int)position.x - size/2 + 3,
-        (int)position.y - size/2 + 3,
-        size, size,
-        {0, 0, 0, 80}
-    );
-
-    // Draw enemy block
-    DrawRectangle(
-        (int)position.x - size/2,
-        (int)position.y - size/2,
-        size, size,
-        drawColor
-    );
-
-    // Draw pixel border
-    DrawRectangleLines(
-        (int)position.x - size/2,
-        (int)position.y - size/2,
-        size, size,
-        {255, 255, 255, 150}
-    );
-
-    // Draw eyes for chasing enemies
-    if (type == EnemyType::CHASING) {
-        int eyeSize = size / 5;
-        Color eyeColor = (chasingState == ChasingState::BLOCKED) ? BLUE : WHITE;
-        DrawRectangle(
-            (int)position.x - size/4 - eyeSize/2,
-            (int)position.y - size/4 - eyeSize/2,
-            eyeSize, eyeSize,
-            eyeColor
-        );
-        DrawRectangle(
-            (int)position.x + size/4 - eyeSize/2,
-            (int)position.y - size/4 - eyeSize/2,
-            eyeSize, eyeSize,
-            eyeColor
-        );
-    }
-    
-    // Draw health bar above enemy
-    if (health < maxHealth) {
-        int barWidth = size;
-        int barHeight = 4;
-        float healthPercent = (float)health / maxHealth;
-        DrawRectangle(
-            (int)position.x - barWidth/2,
-            (int)position.y - size/2 - 10,
-            barWidth, barHeight,
-            {50, 50, 50, 200}
-        );
-        Color hpColor = isVulnerable() ? RED : (Color){255, 50, 50, 255};
-        DrawRectangle(
-            (int)position.x - barWidth/2,
-            (int)position.y - size/2 - 10,
-            (int)(barWidth * healthPercent), barHeight,
-            hpColor
-        );
-    }
+    // Eyes for chasing enemies
+    sprite.eyes = (type == EnemyType::CHASING);
+    sprite.eyeColor = (chasingState == ChasingState::BLOCKED) ? BLUE : WHITE;
+
+    sprite.healthPercent = (float)getHealth() / maxHealth;
+    sprite.hpColor = isVulnerable() ? RED : (Color){255, 50, 50, 255};
+    return sprite;
 }
 
 void Enemy::takeDamage(int dmg) {
-    health -= dmg;
-    if (health <= 0) {
-        alive = false;
+    health() -= dmg;
+    if (health() <= 0) {
+        alive() = false;
     }
 }
 
 void Enemy::growByArea(int eatenSize) {
-    float oldArea = size * size;
+    float oldArea = size() * size();
     float eatenArea = eatenSize * eatenSize;
     float newArea = oldArea + eatenArea;
     int newSize = (int)sqrtf(newArea);
@@ -352,49 +341,61 @@ void Enemy::setSize(int newSize) {
     if (newSize < 10) newSize = 10;
     if (newSize > 300) newSize = 300;
     
-    size = newSize;
-    float healthPercent = (health > 0) ? (float)health / maxHealth : 1.0f;
+    // Growing can push into neighbours, so resolve it awake
+    wake();
+    size() = newSize;
+    float healthPercent = (health() > 0) ? (float)health() / maxHealth : 1.0f;
     updateStatsForSize();
-    health = (int)(maxHealth * healthPercent);
-    if (health < 1) health = 1;
+    health() = (int)(maxHealth * healthPercent);
+    if (health() < 1) health() = 1;
 }
 
-bool Enemy::checkCollisionWith(const Enemy* other) const {
-    if (!other || !other->isAlive() || other == this) return false;
-    
-    float dx = fabs(position.x - other->getPosition().x);
-    float dy = fabs(position.y - other->getPosition().y);
-    float combinedHalfSize = (size + other->getSize()) / 2.0f;
-    
-    return (dx < combinedHalfSize && dy < combinedHalfSize);
+void Enemy::tryEatBullet(BulletPool& bullets, const BulletGrid& bulletGrid) {
+    int row = findEdibleBullet(bullets, bulletGrid);
+    if (row >= 0) {
+        eatBullet(bullets, row);
+    }
 }
 
-void Enemy::tryEatBullet(std::vector<Bullet*>& bullets) {
-    if (type != EnemyType::STATIONARY) return;
+int Enemy::findEdibleBullet(const BulletPool& bullets, const BulletGrid& bulletGrid) const {
+    if (type != EnemyType::STATIONARY) return -1;
     
-    for (auto* bullet : bullets) {
-        if (!bullet->isAlive()) continue;
-        
-        float dx = fabs(position.x - bullet->getPosition().x);
-        float dy = fabs(position.y - bullet->getPosition().y);
-        float combinedHalfSize = (size + bullet->getSize()) / 2.0f;
+    // Only bullets bucketed around this enemy can touch it
+    int nearby[MAX_EAT_CANDIDATES];
+    Vector2 pos = getPosition();
+    int enemySize = getSize();
+    float half = enemySize / 2.0f;
+    int count = bulletGrid.queryRect({pos.x - half, pos.y - half, (float)enemySize, (float)enemySize},
+                                     nearby, MAX_EAT_CANDIDATES);
+    
+    for (int i = 0; i < count; i++) {
+        int row = nearby[i];
+        if (!bullets.isAlive(row)) continue;
         
-        if (dx < combinedHalfSize && dy < combinedHalfSize) {
-            // Eat the bullet and grow
-            growByArea(bullet->getSize());
-            bullet->kill();
-            
-            // Visual effect
-            // (particles would be spawned in game.cpp)
-            break;  // Only eat one bullet per frame
+        // Swept test so fast bullets can't pass through between frames
+        Vector2 from = bullets.previousPosition[row];
+        float toi;
+        if (sweepAABB(from, bullets.position[row] - from, BulletPool::SIZE / 2.0f,
+                      pos, half, toi)) {
+            return row;  // Only eat one bullet per frame
         }
     }
+    return -1;
+}
+
+void Enemy::eatBullet(BulletPool& bullets, int row) {
+    // Eat the bullet and grow
+    growByArea(BulletPool::SIZE);
+    bullets.kill(row);
+
+    // Visual effect
+    // (particles would be spawned in game.cpp)
 }
 
-void Enemy::tryShootBullet(std::vector<Bullet*>& bullets) {
+void Enemy::tryShootBullet(EnemyCommandBuffer& commands, float dt) {
     if (type != EnemyType::FLOATING) return;
     
-    phaseTime += GetFrameTime();
+    phaseTime += dt;
     
     float interval = 2.0f;
     
@@ -411,36 +412,35 @@ void Enemy::tryShootBullet(std::vector<Bullet*>& bullets) {
         return;
     }
     
-    shootTimer += GetFrameTime();
+    shootTimer += dt;
     if (shootTimer >= interval) {
         shootTimer = 0;
         
-        float angle = ((float)(rand() % 360)) * DEG2RAD;
+        float angle = (float)random.nextInt(360) * DEG2RAD;
         Vector2 dir = {cosf(angle), sinf(angle)};
         
-        int damage = size / 3;
-        Bullet* bullet = new Bullet(position, dir, damage, -1);
-        bullets.push_back(bullet);
+        int damage = size() / 3;
+        commands.shots.push_back({position(), dir, damage});
     }
 }
 
-void Enemy::updateFloating(float dt) {
+void Enemy::updateFloating() {
     // Random wandering with momentum
-    float angleChange = ((float)(rand() % 20 - 10)) * DEG2RAD;
-    float currentAngle = atan2f(velocity.y, velocity.x);
+    float angleChange = (float)(random.nextInt(20) - 10) * DEG2RAD;
+    float currentAngle = atan2f(velocity().y, velocity().x);
     float newAngle = currentAngle + angleChange;
     
     // Apply steering force
     Vector2 desiredVel = {cosf(newAngle) * speed, sinf(newAngle) * speed};
-    Vector2 steering = {(desiredVel.x - velocity.x) * 2.0f, 
-                        (desiredVel.y - velocity.y) * 2.0f};
+    Vector2 steering = {(desiredVel.x - velocity().x) * 2.0f, 
+                        (desiredVel.y - velocity().y) * 2.0f};
     
-    applyForce({steering.x * mass, steering.y * mass});
+    applyForce({steering.x * mass(), steering.y * mass()});
 }
 
-void Enemy::updateChasing(float dt, Vector2 playerPos) {
+void Enemy::updateChasing(Vector2 playerPos) {
     // Move towards player using forces
-    Vector2 dir = {playerPos.x - position.x, playerPos.y - position.y};
+    Vector2 dir = {playerPos.x - position().x, playerPos.y - position().y};
     float dist = Vector2Length(dir);
     
     if (dist > 0.1f) {
@@ -450,7 +450,7 @@ void Enemy::updateChasing(float dt, Vector2 playerPos) {
         Vector2 desiredVel = {dir.x * speed, dir.y * speed};
         
         // Steering force
-        Vector2 steering = {desiredVel.x - velocity.x, desiredVel.y - velocity.y};
+        Vector2 steering = {desiredVel.x - velocity().x, desiredVel.y - velocity().y};
         steering = Vector2Normalize(steering);
         steering = steering * FORCE_MULTIPLIER;
         
@@ -458,52 +458,12 @@ void Enemy::updateChasing(float dt, Vector2 playerPos) {
     }
 }
 
-void Enemy::updateStationary(float dt) {
-    // Slight bobbing motion
-    float bob = sinf(GetTime() * 2.0f) * 0.5f;
-    position.y += bob * dt;
+void Enemy::updateStationary() {
+    // The bobbing is drawn only (see getSprite), so a resting enemy
+    // really stands still and can fall asleep
     
     // Dampen any velocity
-    velocity = velocity * 0.9f;
-}
-
-void Enemy::updateBouncing(float dt) {
-    // Constant velocity, bounces off walls
-    position.x += velocity.x * dt;
-    position.y += velocity.y * dt;
-}
-
-void Enemy::checkBounds() {
-    int halfSize = size / 2;
-
-    if (type == EnemyType::BOUNCING) {
-        if (position.x < halfSize || position.x > WORLD_WIDTH - halfSize) {
-            velocity.x = -velocity.x;
-            position.x = fmaxf(halfSize, fminf(WORLD_WIDTH - halfSize, position.x));
-        }
-        if (position.y < halfSize || position.y > WORLD_HEIGHT - halfSize) {
-            velocity.y = -velocity.y;
-            position.y = fmaxf(halfSize, fminf(WORLD_HEIGHT - halfSize, position.y));
-        }
-    } else {
-        // Clamp to world bounds
-        if (position.x < halfSize) {
-            position.x = halfSize;
-            velocity.x = fabsf(velocity.x) * 0.5f;
-        }
-        if (position.x > WORLD_WIDTH - halfSize) {
-            position.x = WORLD_WIDTH - halfSize;
-            velocity.x = -fabsf(velocity.x) * 0.5f;
-        }
-        if (position.y < halfSize) {
-            position.y = halfSize;
-            velocity.y = fabsf(velocity.y) * 0.5f;
-        }
-        if (position.y > WORLD_HEIGHT - halfSize) {
-            position.y = WORLD_HEIGHT - halfSize;
-            velocity.y = -fabsf(velocity.y) * 0.5f;
-        }
-    }
+    velocity() = velocity() * 0.9f;
 }
 
 } // namespace BlockEater
@@ -3,12 +3,15 @@
 
 #include "raylib.h"
 #include "game.h"
+#include "entities.h"
 #include <vector>
 
 namespace BlockEater {
 
-// Forward declaration
-class Bullet;
+// Forward declarations
+class BulletPool;
+class SpatialHash;
+class BulletGrid;
 
 // Enemy types
 enum class EnemyType {
@@ -25,35 +28,104 @@ enum class ChasingState {
     VULNERABLE   // Health < 30%, can be eaten by smaller enemies
 };
 
+// Side effects of enemy AI on shared state. update() may run on several
+// threads at once, so it records these instead of touching the bullet pool;
+// Game applies them in a fixed order once all enemies have updated.
+struct EnemyCommandBuffer {
+    struct Shot {
+        Vector2 position;
+        Vector2 direction;
+        int damage;
+    };
+    struct Eat {
+        Enemy* enemy;
+        int bulletRow;
+    };
+
+    std::vector<Shot> shots;
+    std::vector<Eat> eats;
+
+    void clear() { shots.clear(); eats.clear(); }
+};
+
+// What the renderer needs to draw one enemy, captured at the end of a tick
+struct EnemySprite {
+    Vector2 from;  // Position at the start of the tick
+    Vector2 to;    // Position at the end of the tick
+    int size;
+    Color color;   // Already tinted for vulnerable/blocked
+    bool eyes;
+    Color eyeColor;
+    float healthPercent;  // Bar is drawn below 1
+    Color hpColor;
+
+    void draw(float alpha) const;  // alpha blends from -> to
+
+    // Every sprite, in order, as quads of one rlgl batch: shadow, body,
+    // outline, eyes and health bar all share the default texture, so any
+    // number of enemies costs a few draw calls (one per full batch)
+    static void drawBatch(const EnemySprite* sprites, int count, float alpha);
+    static constexpr int MAX_QUADS = 10;  // Per sprite
+};
+
+// Simulation level of detail, from the distance to the player (see
+// EnemyStore::assignLod). Lower tiers run their AI less often.
+enum class LodTier {
+    FULL,       // On or near the screen: AI every tick
+    REDUCED,    // Middle band: AI every few ticks, steering held in between
+    AGGREGATE   // Far away: rare AI, no shooting, no contacts with other far enemies
+};
+
+// Hot components (position, velocity, size, mass, health, alive) live in the
+// EnemyStore table of this enemy's type; the object keeps AI state and
+// other cold data. Create and destroy enemies through the store.
 class Enemy {
 public:
-    Enemy(EnemyType type, Vector2 pos, int size);
+    Enemy(EnemyStore& store, EnemyType type, Vector2 pos, int size);
     ~Enemy();
 
-    void update(float dt, Vector2 playerPos, std::vector<Bullet*>& bullets, 
-                const std::vector<Enemy*>& allEnemies);
-    void draw();
+    // AI and steering; integration and world bounds run in EnemyStore.
+    // Safe to run in parallel: writes only this enemy's own state, reads
+    // other enemies' state from the start of the tick, and records bullet
+    // spawns and eats in commands.
+    void update(float dt, Vector2 playerPos, const BulletPool& bullets,
+                const SpatialHash& grid, const BulletGrid& bulletGrid,
+                EnemyCommandBuffer& commands);
+    // Runs update() on the cadence of this enemy's LOD tier, with the time
+    // since its last update; in between it keeps applying the last steering
+    void simulate(unsigned int tick, float dt, Vector2 playerPos, const BulletPool& bullets,
+                  const SpatialHash& grid, const BulletGrid& bulletGrid,
+                  EnemyCommandBuffer& commands);
+    EnemySprite getSprite(float simTime) const;  // simTime drives the STATIONARY bob
 
     // Getters
-    Vector2 getPosition() const { return position; }
-    Vector2 getVelocity() const { return velocity; }
-    int getSize() const { return size; }
-    float getMass() const { return mass; }
-    int getHealth() const { return health; }
+    unsigned int getId() const { return id; }  // Stable for the enemy's lifetime, spawn order
+    Vector2 getPosition() const { return table->position[row]; }
+    Vector2 getPreviousPosition() const { return table->previousPosition[row]; }  // Start of the tick
+    Vector2 getVelocity() const { return table->velocity[row]; }
+    int getSize() const { return table->size[row]; }
+    float getMass() const { return table->mass[row]; }
+    int getHealth() const { return table->health[row]; }
     int getMaxHealth() const { return maxHealth; }
     EnemyType getType() const { return type; }
     Color getColor() const { return color; }
-    bool isAlive() const { return alive; }
+    bool isAlive() const { return table->alive[row] != 0; }
     int getExpValue() const { return expValue; }
     float getSpeed() const { return speed; }
     bool isVulnerable() const;  // Health < 30% for CHASING/FLOATING
     bool isBlocked() const { return blockedTimer > 0; }
+    LodTier getLodTier() const { return lodTier; }
+
+    // Broadphase registration (owned by SpatialHash)
+    int getGridProxy() const { return gridProxy; }
+    void setGridProxy(int proxy) { gridProxy = proxy; }
 
     // Setters
-    void setPosition(Vector2 pos) { position = pos; }
-    void setVelocity(Vector2 vel) { velocity = vel; }
+    void setPosition(Vector2 pos) { wake(); position() = pos; }
+    void setVelocity(Vector2 vel) { wake(); velocity() = vel; }
+    bool isAsleep() const { return row >= table->awakeCount; }
     void takeDamage(int dmg);
-    void kill() { alive = false; }
+    void kill() { alive() = 0; }
     
     // Size management - grows based on area
     void growByArea(int eatenSize);
@@ -61,33 +133,38 @@ public:
     
     // Physics
     void applyForce(Vector2 force);
-    void applyRigidBodyCollision(Enemy* other);  // Enemy-enemy collision
+    void applyRigidBodyCollision(Enemy* other, Vector2 normal, float penetration);  // Enemy-enemy contact
     void applyRigidBodyCollision(float otherMass, Vector2 otherVelocity, Vector2 collisionNormal);  // Player-enemy collision
     void applyBouncingDamage(Enemy* other);  // BOUNCING type special damage
     
-    // Check collision with another enemy
-    bool checkCollisionWith(const Enemy* other) const;
-    
     // Bullet interaction
-    void tryEatBullet(std::vector<Bullet*>& bullets);  // For STATIONARY
-    void tryShootBullet(std::vector<Bullet*>& bullets);  // For FLOATING
+    void tryEatBullet(BulletPool& bullets, const BulletGrid& bulletGrid);  // For STATIONARY
+    int findEdibleBullet(const BulletPool& bullets, const BulletGrid& bulletGrid) const;  // Row or -1
+    void eatBullet(BulletPool& bullets, int row);
+    void tryShootBullet(EnemyCommandBuffer& commands, float dt);  // For FLOATING
 
     // CHASING AI
-    void checkIfBlocked(const std::vector<Enemy*>& allEnemies);
+    void checkIfBlocked(const SpatialHash& grid);
 
 private:
-    Vector2 position;
-    Vector2 velocity;
-    Vector2 acceleration;
-    int size;
-    float mass;  // Mass proportional to volume (size^3)
-    int health;
+    friend class EnemyStore;
+    EnemyStore* store;
+    EnemyTable* table;  // Archetype table for this type
+    int row;            // Row in the table, updated when rows move
+    unsigned int id;
+    Random random;      // Own stream, split from the store's by id
+
     int maxHealth;
     EnemyType type;
     Color color;
-    bool alive;
     int expValue;
     float speed;
+    int gridProxy;
+
+    // Level of detail
+    LodTier lodTier;
+    float lodTime;               // Sim time since update() last ran
+    Vector2 heldAcceleration;    // Steering from the last update(), reapplied until the next
     
     // AI state
     ChasingState chasingState;
@@ -100,17 +177,28 @@ private:
     float phaseTime;
     static constexpr float PHASE_DURATION = 5.0f;
     
-    // Physics constants
-    static constexpr float FRICTION = 0.98f;
+    // Physics constants (friction is applied by EnemyStore::integrate)
     static constexpr float FORCE_MULTIPLIER = 100.0f;
+    
+    // Neighbors inspected for blocked detection
+    static constexpr int MAX_BLOCK_NEIGHBORS = 8;
+    // Bullets inspected per frame when a STATIONARY enemy tries to eat
+    static constexpr int MAX_EAT_CANDIDATES = 16;
 
-    void updateFloating(float dt);
-    void updateChasing(float dt, Vector2 playerPos);
-    void updateStationary(float dt);
-    void updateBouncing(float dt);
-    void checkBounds();
-    void updatePhysics(float dt);
+    void updateFloating();
+    void updateChasing(Vector2 playerPos);
+    void updateStationary();
     void updateStatsForSize();
+    void wake() { store->wake(this); }  // Anything that moves or grows it
+
+    // Column accessors for this enemy's row
+    Vector2& position() { return table->position[row]; }
+    Vector2& velocity() { return table->velocity[row]; }
+    Vector2& acceleration() { return table->acceleration[row]; }
+    int& size() { return table->size[row]; }
+    float& mass() { return table->mass[row]; }  // Mass proportional to volume (size^3)
+    int& health() { return table->health[row]; }
+    unsigned char& alive() { return table->alive[row]; }
 };
 
 } // namespace BlockEater
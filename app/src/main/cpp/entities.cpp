@@ -0,0 +1,281 @@
+#include "entities.h"
+#include "enemy.h"
+#include "spatial.h"
+#include "integrator.h"
+#include <cmath>
+#include <new>
+#include <utility>
+
+namespace BlockEater {
+
+static_assert(sizeof(Enemy) >= sizeof(void*), "A free enemy slot holds the next pointer");
+
+EnemyStore::EnemyStore()
+    : nextId(0)
+    , freeSlots(nullptr)
+{
+}
+
+EnemyStore::~EnemyStore() {
+    clear();
+    while (freeSlots) {
+        FreeSlot* next = freeSlots->next;
+        ::operator delete(freeSlots);
+        freeSlots = next;
+    }
+}
+
+Enemy* EnemyStore::spawn(EnemyType type, Vector2 pos, int size) {
+    void* storage;
+    if (freeSlots) {
+        storage = freeSlots;
+        freeSlots = freeSlots->next;
+    } else {
+        storage = ::operator new(sizeof(Enemy));
+    }
+    return new (storage) Enemy(*this, type, pos, size);
+}
+
+void EnemyStore::release(Enemy* enemy) {
+    enemy->~Enemy();
+    freeSlots = new (enemy) FreeSlot{freeSlots};
+}
+
+void EnemyStore::reserve(int count) {
+    // Pooled storage for every enemy beyond the ones alive or already pooled
+    int pooled = this->count();
+    for (FreeSlot* slot = freeSlots; slot; slot = slot->next) {
+        pooled++;
+    }
+    for (; pooled < count; pooled++) {
+        freeSlots = new (::operator new(sizeof(Enemy))) FreeSlot{freeSlots};
+    }
+
+    // Each table may end up holding all of them
+    int perType = count;
+    for (auto& tbl : tables) {
+        tbl.position.reserve(perType);
+        tbl.previousPosition.reserve(perType);
+        tbl.velocity.reserve(perType);
+        tbl.acceleration.reserve(perType);
+        tbl.size.reserve(perType);
+        tbl.mass.reserve(perType);
+        tbl.health.reserve(perType);
+        tbl.alive.reserve(perType);
+        tbl.owner.reserve(perType);
+        tbl.restTime.reserve(perType);
+    }
+}
+
+int EnemyStore::attach(EnemyTable& tbl, Enemy* owner, Vector2 pos, int size) {
+    tbl.position.push_back(pos);
+    tbl.previousPosition.push_back(pos);
+    tbl.velocity.push_back({0, 0});
+    tbl.acceleration.push_back({0, 0});
+    tbl.size.push_back(size);
+    tbl.mass.push_back(1.0f);
+    tbl.health.push_back(0);
+    tbl.alive.push_back(1);
+    tbl.owner.push_back(owner);
+    tbl.restTime.push_back(0);
+
+    // New enemies start awake: swap the row to the front of the sleepers
+    swapRows(tbl, tbl.count() - 1, tbl.awakeCount);
+    return tbl.awakeCount++;
+}
+
+void EnemyStore::swapRows(EnemyTable& tbl, int a, int b) {
+    if (a == b) return;
+    std::swap(tbl.position[a], tbl.position[b]);
+    std::swap(tbl.previousPosition[a], tbl.previousPosition[b]);
+    std::swap(tbl.velocity[a], tbl.velocity[b]);
+    std::swap(tbl.acceleration[a], tbl.acceleration[b]);
+    std::swap(tbl.size[a], tbl.size[b]);
+    std::swap(tbl.mass[a], tbl.mass[b]);
+    std::swap(tbl.health[a], tbl.health[b]);
+    std::swap(tbl.alive[a], tbl.alive[b]);
+    std::swap(tbl.owner[a], tbl.owner[b]);
+    std::swap(tbl.restTime[a], tbl.restTime[b]);
+    tbl.owner[a]->row = a;
+    tbl.owner[b]->row = b;
+}
+
+void EnemyStore::destroy(Enemy* enemy) {
+    if (!enemy) return;
+
+    // An awake row first trades places with the last awake row, so the
+    // awake prefix stays contiguous
+    EnemyTable& tbl = *enemy->table;
+    if (enemy->row < tbl.awakeCount) {
+        tbl.awakeCount--;
+        swapRows(tbl, enemy->row, tbl.awakeCount);
+    }
+
+    // Move the last row into the hole so every column stays dense
+    swapRows(tbl, enemy->row, tbl.count() - 1);
+    tbl.position.pop_back();
+    tbl.previousPosition.pop_back();
+    tbl.velocity.pop_back();
+    tbl.acceleration.pop_back();
+    tbl.size.pop_back();
+    tbl.mass.pop_back();
+    tbl.health.pop_back();
+    tbl.alive.pop_back();
+    tbl.owner.pop_back();
+    tbl.restTime.pop_back();
+
+    release(enemy);
+}
+
+void EnemyStore::clear() {
+    for (auto& tbl : tables) {
+        for (auto* enemy : tbl.owner) {
+            release(enemy);
+        }
+        tbl.position.clear();
+        tbl.previousPosition.clear();
+        tbl.velocity.clear();
+        tbl.acceleration.clear();
+        tbl.size.clear();
+        tbl.mass.clear();
+        tbl.health.clear();
+        tbl.alive.clear();
+        tbl.owner.clear();
+        tbl.restTime.clear();
+        tbl.awakeCount = 0;
+    }
+    nextId = 0;
+}
+
+void EnemyStore::setSeed(uint64_t seed) {
+    random = Random(seed, RandomStream::ENEMY);
+}
+
+int EnemyStore::count() const {
+    int total = 0;
+    for (const auto& tbl : tables) {
+        total += tbl.count();
+    }
+    return total;
+}
+
+void EnemyStore::savePreviousPositions() {
+    for (auto& tbl : tables) {
+        tbl.previousPosition = tbl.position;  // Same size, copies without allocating
+    }
+}
+
+void EnemyStore::integrate(float dt) {
+    // Rows killed earlier this tick (blink) move too; nothing reads them
+    // before removeDead
+    for (auto& tbl : tables) {
+        integrateBodies(tbl.position.data(), tbl.velocity.data(), tbl.acceleration.data(),
+                        tbl.awakeCount, dt, FRICTION);
+    }
+}
+
+void EnemyStore::clampToWorld() {
+    for (int t = 0; t < ARCHETYPE_COUNT; t++) {
+        EnemyTable& tbl = tables[t];
+        if ((EnemyType)t == EnemyType::BOUNCING) {
+            reflectBodiesOffWorld(tbl.position.data(), tbl.velocity.data(), tbl.size.data(), tbl.awakeCount);
+        } else {
+            clampBodiesToWorld(tbl.position.data(), tbl.velocity.data(), tbl.size.data(), tbl.awakeCount);
+        }
+    }
+}
+
+void EnemyStore::syncGrid(SpatialHash& grid) {
+    // Cheap when an enemy stays within its cells, so run at every sync
+    // point; sleepers don't move and were placed when they fell asleep
+    for (auto& tbl : tables) {
+        for (int i = 0; i < tbl.awakeCount; i++) {
+            grid.update(tbl.owner[i]);
+        }
+    }
+}
+
+void EnemyStore::removeDead(SpatialHash& grid) {
+    for (auto& tbl : tables) {
+        // Walk backwards so the row swapped into a hole was already visited
+        for (int i = tbl.count() - 1; i >= 0; i--) {
+            if (tbl.alive[i]) continue;
+            Enemy* enemy = tbl.owner[i];
+            grid.remove(enemy);
+            destroy(enemy);
+        }
+    }
+}
+
+void EnemyStore::updateSleep(float dt, SpatialHash& grid) {
+    // Only STATIONARY enemies rest for long; the others always steer
+    EnemyTable& tbl = table(EnemyType::STATIONARY);
+
+    // Backwards, so the row swapped in by sleep() was already checked
+    for (int i = tbl.awakeCount - 1; i >= 0; i--) {
+        Vector2 v = tbl.velocity[i];
+        if (v.x * v.x + v.y * v.y >= SLEEP_SPEED * SLEEP_SPEED) {
+            tbl.restTime[i] = 0;
+            continue;
+        }
+        tbl.restTime[i] += dt;
+        if (tbl.restTime[i] >= SLEEP_DELAY) {
+            Enemy* enemy = tbl.owner[i];
+            sleep(enemy);
+            grid.update(enemy);  // To the static layer
+        }
+    }
+}
+
+void EnemyStore::assignLod(Vector2 focus) {
+    float fullX = SCREEN_WIDTH / 2.0f + LOD_MARGIN;
+    float fullY = SCREEN_HEIGHT / 2.0f + LOD_MARGIN;
+    float reducedX = fullX * LOD_REDUCED_SCALE;
+    float reducedY = fullY * LOD_REDUCED_SCALE;
+
+    for (auto& tbl : tables) {
+        for (int i = 0; i < tbl.count(); i++) {
+            float dx = fabsf(tbl.position[i].x - focus.x);
+            float dy = fabsf(tbl.position[i].y - focus.y);
+            LodTier tier = LodTier::AGGREGATE;
+            if (dx < fullX && dy < fullY) {
+                tier = LodTier::FULL;
+            } else if (dx < reducedX && dy < reducedY) {
+                tier = LodTier::REDUCED;
+            }
+            tbl.owner[i]->lodTier = tier;
+        }
+    }
+}
+
+void EnemyStore::sleep(Enemy* enemy) {
+    EnemyTable& tbl = *enemy->table;
+    int row = enemy->row;
+    if (row >= tbl.awakeCount) return;
+
+    tbl.velocity[row] = {0, 0};
+    tbl.acceleration[row] = {0, 0};
+    tbl.previousPosition[row] = tbl.position[row];
+    tbl.awakeCount--;
+    swapRows(tbl, row, tbl.awakeCount);
+}
+
+void EnemyStore::wake(Enemy* enemy) {
+    EnemyTable& tbl = *enemy->table;
+    int row = enemy->row;
+    if (row < tbl.awakeCount) return;
+
+    tbl.restTime[row] = 0;
+    swapRows(tbl, row, tbl.awakeCount);
+    tbl.awakeCount++;
+}
+
+int EnemyStore::awakeCount() const {
+    int total = 0;
+    for (const auto& tbl : tables) {
+        total += tbl.awakeCount;
+    }
+    return total;
+}
+
+} // namespace BlockEater
@@ -0,0 +1,136 @@
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include "raylib.h"
+#include "game.h"
+#include "jobs.h"
+#include "random.h"
+#include <vector>
+
+namespace BlockEater {
+
+class Enemy;
+class SpatialHash;
+enum class EnemyType;
+
+// Hot components of one enemy archetype, one column per component.
+// Row i of every column belongs to the same enemy; owner[i] holds its
+// cold data (AI state, color, timers). Rows [0, awakeCount) are awake,
+// sleeping rows follow them, so physics only walks the awake prefix.
+struct EnemyTable {
+    std::vector<Vector2> position;
+    std::vector<Vector2> previousPosition;  // At the start of the tick (render interpolation)
+    std::vector<Vector2> velocity;
+    std::vector<Vector2> acceleration;  // Force accumulator, cleared by integrate()
+    std::vector<int> size;
+    std::vector<float> mass;
+    std::vector<int> health;
+    std::vector<unsigned char> alive;
+    std::vector<Enemy*> owner;
+    std::vector<float> restTime;  // How long the row has been nearly still
+    int awakeCount = 0;
+
+    int count() const { return (int)owner.size(); }
+};
+
+// Archetype storage for all enemies: one table per EnemyType, so systems
+// that only care about one kind of enemy walk a single dense table and
+// physics walks plain arrays instead of chasing Enemy pointers.
+// Enemy pointers stay valid until destroy(); rows move on removal.
+class EnemyStore {
+public:
+    static constexpr int ARCHETYPE_COUNT = 4;  // One per EnemyType
+    static constexpr float FRICTION = 0.98f;
+
+    // Sleeping: a STATIONARY enemy slower than SLEEP_SPEED for SLEEP_DELAY
+    // seconds stops being integrated and moves to the grid's static layer
+    static constexpr float SLEEP_SPEED = 2.0f;
+    static constexpr float SLEEP_DELAY = 0.5f;
+
+    // Simulation LOD around the player: within the screen plus LOD_MARGIN
+    // enemies update every tick, within LOD_REDUCED_SCALE screens every
+    // LOD_REDUCED_PERIOD ticks, beyond that every LOD_AGGREGATE_PERIOD
+    static constexpr float LOD_MARGIN = 200.0f;
+    static constexpr float LOD_REDUCED_SCALE = 2.0f;
+    static constexpr int LOD_REDUCED_PERIOD = 4;
+    static constexpr int LOD_AGGREGATE_PERIOD = 16;
+
+    EnemyStore();
+    ~EnemyStore();
+
+    Enemy* spawn(EnemyType type, Vector2 pos, int size);
+    void destroy(Enemy* enemy);  // Swap-removes the row, returns the enemy to the pool
+    void clear();
+    void reserve(int count);  // Room for count enemies, of any mix of types, without allocating
+    void setSeed(uint64_t seed);  // Session seed for the per-enemy streams
+
+    int count() const;
+    EnemyTable& table(EnemyType type) { return tables[(int)type]; }
+    const EnemyTable& table(EnemyType type) const { return tables[(int)type]; }
+
+    // Systems (linear passes over the columns)
+    void savePreviousPositions();  // Call at the start of every tick
+    void integrate(float dt);  // Acceleration -> velocity (with friction) -> position
+    void clampToWorld();       // BOUNCING reflects off walls, others stop at them
+    void syncGrid(SpatialHash& grid);
+    void removeDead(SpatialHash& grid);
+    void updateSleep(float dt, SpatialHash& grid);  // Puts resting enemies to sleep
+    void assignLod(Vector2 focus);  // LOD tier of every enemy from its distance to focus
+
+    // Sleep state (wake() is cheap when already awake; syncGrid moves a
+    // woken enemy back to the grid's dynamic layer)
+    void wake(Enemy* enemy);
+    int awakeCount() const;
+
+    // Visit every enemy, archetype by archetype
+    template <typename Fn>
+    void forEach(Fn fn) {
+        for (int t = 0; t < ARCHETYPE_COUNT; t++) {
+            EnemyTable& tbl = tables[t];
+            for (int i = 0; i < tbl.count(); i++) {
+                fn(tbl.owner[i]);
+            }
+        }
+    }
+
+    // Visit every enemy on the job system, grainSize enemies per chunk.
+    // fn(enemy, chunk) runs on any thread; enemies are numbered across the
+    // tables in forEach order, so chunks cover the same enemies every run.
+    template <typename Fn>
+    void parallelForEach(JobSystem& jobs, int grainSize, Fn fn) {
+        int start[ARCHETYPE_COUNT + 1];
+        start[0] = 0;
+        for (int t = 0; t < ARCHETYPE_COUNT; t++) {
+            start[t + 1] = start[t] + tables[t].count();
+        }
+        jobs.parallelFor(start[ARCHETYPE_COUNT], grainSize, [&](int begin, int end, int chunk) {
+            int t = 0;
+            for (int i = begin; i < end; i++) {
+                while (i >= start[t + 1]) t++;
+                fn(tables[t].owner[i - start[t]], chunk);
+            }
+        });
+    }
+
+private:
+    EnemyTable tables[ARCHETYPE_COUNT];
+    unsigned int nextId;  // Next Enemy id, restarts on clear()
+    Random random;        // Split per enemy id
+
+    // Storage of destroyed enemies, reused by spawn() so steady-state
+    // spawning never touches the heap; linked through the storage itself
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+    FreeSlot* freeSlots;
+    void release(Enemy* enemy);
+
+    friend class Enemy;
+    int attach(EnemyTable& tbl, Enemy* owner, Vector2 pos, int size);
+    static void swapRows(EnemyTable& tbl, int a, int b);
+    void sleep(Enemy* enemy);
+};
+
+} // namespace BlockEater
+
+#endif // ENTITIES_H
@@ -4,39 +4,85 @@
 #include "particles.h"
 #include "ui.h"
 #include "audio.h"
-#include "modes.h"
 #include "controls.h"
 #include "assets.h"
 #include "camera.h"
 #include "bullet.h"
 #include "skills.h"
 #include "userManager.h"
+#include "entities.h"
+#include "snapshot.h"
+#include "replay.h"
+#include "simulation.h"
+#include "profiler.h"
+#include "allocTracker.h"
+#include "scenario.h"
+#include "spatial.h"
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
 
+namespace {
+
+// Clock shared by the render and sim threads (input stamps, tick times)
+double clockSeconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Fresh seed for a new run
+uint64_t newSessionSeed() {
+    using namespace std::chrono;
+    return (uint64_t)system_clock::now().time_since_epoch().count();
+}
+
+// area grown by margin on every side
+Rectangle padRect(Rectangle area, float margin) {
+    return {area.x - margin, area.y - margin, area.width + 2 * margin, area.height + 2 * margin};
+}
+
+// Enemies in the built-in stress runs of the settings screen
+const int STRESS_PRESETS[] = {2000, 10000, 50000};
+const int STRESS_PRESET_COUNT = sizeof(STRESS_PRESETS) / sizeof(STRESS_PRESETS[0]);
+
+} // namespace
+
 using namespace BlockEater;
 
 Game::Game()
-    : player(nullptr)
-    , particles(nullptr)
+    : sim(nullptr)
     , ui(nullptr)
     , audio(nullptr)
     , controls(nullptr)
     , assets(nullptr)
     , camera(nullptr)
-    , skillManager(nullptr)
     , userManager(nullptr)
-    , modeManager(nullptr)
     , state(GameState::MENU)
     , previousState(GameState::MENU)
     , mode(GameMode::ENDLESS)
     , controlMode(ControlMode::VIRTUAL_JOYSTICK)
-    , score(0)
     , currentLevel(1)
-    , timeRemaining(0)
     , deltaTime(0)
-    , gameTime(0)
+    , tickRate(DEFAULT_TICK_RATE)
+    , renderAlpha(0)
+    , tickInput{0, 0}
+    , tickView{0, 0, SCREEN_WIDTH, SCREEN_HEIGHT}
+    , cullStats{0, 0, 0, 0, 0, 0}
+    , runOver(false)
+    , snapshots(nullptr)
+    , inputQueue(nullptr)
+    , simEvents(nullptr)
+    , replay(nullptr)
+    , replaying(false)
+    , replayDiverged(false)
+    , scenario(nullptr)
+    , stressing(false)
+    , nextStressPreset(0)
+    , simRunning(false)
+    , frameAllocations(0)
+    , frameAllocatedBytes(0)
     , nameInputBuffer{0}  // Initialize empty string
     , timeSinceLastSave(0)
     , hasRecentSave(false)
@@ -66,16 +112,10 @@ void Game::init() {
     // Sync control mode with UI
     ui->setControlMode(controlMode);
 
-    particles = new ParticleSystem();
-
     // Initialize camera
     camera = new GameCamera();
     camera->init();
 
-    // Initialize skill manager
-    skillManager = new SkillManager();
-    skillManager->init();
-
     // Initialize user manager
     userManager = new UserManager();
     userManager->init();
@@ -83,63 +123,113 @@ void Game::init() {
     // Set user manager for UI access
     ui->setUserManager(userManager);
 
-    // Initialize mode manager
-    modeManager = new GameModeManager();
-    modeManager->init(mode);
+    // Create the world (player, enemies, skills, modes, worker pool)
+    sim = new Simulation();
+
+    // Hand-off between the render and simulation threads
+    snapshots = new SnapshotBuffer();
+    inputQueue = new InputQueue();
+    simEvents = new SimEventQueue();
+    replay = new Replay();
+    scenario = new Scenario();
+    reserveSnapshots(Simulation::MAX_ENEMIES);
+}
 
-    // Create player
-    player = new Player();
+void Game::reserveSnapshots(int enemyCount) {
+    // Even with all of them in view, capturing a snapshot doesn't allocate
+    visibleEnemies.reserve(enemyCount);
+    snapshots->reserve(enemyCount);
 }
 
 void Game::run() {
+    Profiler::setThreadName("render");
     while (!WindowShouldClose()) {
         deltaTime = GetFrameTime();
 
-        update();
-        draw();
+        AllocCounts before = AllocTracker::getTotal();
+        {
+            PROFILE_ZONE(ProfileZone::FRAME);
+            update();
+            draw();
+        }
+        AllocCounts frame = AllocTracker::getTotal() - before;
+        frameAllocations = frame.allocations;
+        frameAllocatedBytes = frame.bytes;
     }
 }
 
+void Game::setTickRate(int hz) {
+    // Below 10 Hz motion gets too coarse to interpolate, above 240 the
+    // tick cap would drop time on ordinary frames
+    if (hz < 10) hz = 10;
+    if (hz > 240) hz = 240;
+    tickRate = hz;
+}
+
 void Game::update() {
-    controls->update();
+    {
+        PROFILE_ZONE(ProfileZone::INPUT);
+        controls->update();
 
-    switch (state) {
-        case GameState::MENU:
-            updateMenu();
-            break;
-        case GameState::PLAYING:
-            updatePlaying();
-            break;
-        case GameState::PAUSED:
-            updatePaused();
-            break;
-        case GameState::GAME_OVER:
-            updateGameOver();
-            break;
-        case GameState::LEVEL_SELECT:
-            updateLevelSelect();
-            break;
-        case GameState::SETTINGS:
-            updateSettings();
-            break;
-        case GameState::USER_MENU:
-            updateUserMenu();
-            break;
-        case GameState::NAME_INPUT:
-            updateNameInput();
-            break;
+        switch (state) {
+            case GameState::MENU:
+                updateMenu();
+                break;
+            case GameState::PLAYING:
+                updatePlaying();
+                break;
+            case GameState::PAUSED:
+                updatePaused();
+                break;
+            case GameState::GAME_OVER:
+                updateGameOver();
+                break;
+            case GameState::LEVEL_SELECT:
+                updateLevelSelect();
+                break;
+            case GameState::SETTINGS:
+                updateSettings();
+                break;
+            case GameState::USER_MENU:
+                updateUserMenu();
+                break;
+            case GameState::NAME_INPUT:
+                updateNameInput();
+                break;
+        }
+    }
+
+    // The simulation thread runs exactly while a round is being played
+    bool playing = (state == GameState::PLAYING);
+    if (playing && !simRunning) {
+        startSimulation();
+    } else if (!playing && simRunning) {
+        stopSimulation();
     }
 
-    ui->update(deltaTime);
-    particles->update(deltaTime);
+    {
+        PROFILE_ZONE(ProfileZone::UI);
+        ui->update(deltaTime);
+        handleSimEvents();
+    }
+    if (!simRunning) {
+        sim->particles->update(deltaTime);  // Otherwise the sim thread owns them
+    }
     audio->updateMusic();  // Update music streaming
 }
 
+int Game::getScore() const {
+    return sim->getScore();
+}
+
 void Game::draw() {
     BeginDrawing();
     ClearBackground({20, 20, 40, 255});
 
-    drawBackground();
+    {
+        PROFILE_ZONE(ProfileZone::DRAW_BACKGROUND);
+        drawBackground();
+    }
 
     switch (state) {
         case GameState::MENU:
@@ -168,23 +258,12 @@ void Game::draw() {
             break;
     }
 
-    particles->draw();
-
     EndDrawing();
 }
 
 void Game::shutdown() {
-    // Clear enemies
-    for (auto* enemy : enemies) {
-        delete enemy;
-    }
-    enemies.clear();
-
-    // Clear bullets
-    for (auto* bullet : bullets) {
-        delete bullet;
-    }
-    bullets.clear();
+    // Closed mid-round: the sim thread must be gone before anything is freed
+    stopSimulation();
 
     // Unload background texture
     if (backgroundTexture.id != 0) {
@@ -192,15 +271,17 @@ void Game::shutdown() {
     }
 
     // Delete managers
-    delete player;
-    delete particles;
+    delete sim;
     delete ui;
     delete audio;
     delete controls;
     delete assets;
     delete camera;
-    delete skillManager;
-    delete modeManager;
+    delete snapshots;
+    delete inputQueue;
+    delete simEvents;
+    delete replay;
+    delete scenario;
 }
 
 void Game::updateMenu() {
@@ -243,119 +324,56 @@ void Game::updateMenu() {
 }
 
 void Game::updatePlaying() {
-    // Update camera first (follow player)
-    camera->update(player->getPosition(), deltaTime);
-
-    // Update player - physics-based movement
-    Vector2 input = controls->getInputVector(player->getPosition());
-
-    // DEBUG: Log input being passed to player - use TextFormat
-    TraceLog(LOG_INFO, TextFormat("updatePlaying: input=%i,%i",
-            (int)(input.x * 1000), (int)(input.y * 1000)));
-
-    player->applyJoystickInput(input);
-    player->update(deltaTime, bullets);
-
-    // Update enemies (with bullet shooting for FLOATING types and all enemies list)
-    for (auto* enemy : enemies) {
-        enemy->update(deltaTime, player->getPosition(), bullets, enemies);
-    }
-    
-    // Rigid body collisions between enemies
-    for (size_t i = 0; i < enemies.size(); i++) {
-        for (size_t j = i + 1; j < enemies.size(); j++) {
-            Enemy* e1 = enemies[i];
-            Enemy* e2 = enemies[j];
-            if (!e1->isAlive() || !e2->isAlive()) continue;
-            
-            // Check collision
-            float dx = fabs(e1->getPosition().x - e2->getPosition().x);
-            float dy = fabs(e1->getPosition().y - e2->getPosition().y);
-            float combinedHalfSize = (e1->getSize() + e2->getSize()) / 2.0f;
-            
-            if (dx < combinedHalfSize && dy < combinedHalfSize) {
-                // Apply rigid body collision
-                Vector2 normal = Vector2Normalize(e1->getPosition() - e2->getPosition());
-                e1->applyRigidBodyCollision(e2);
-                
-                // BOUNCING type special: deal damage and push away strongly
-                if (e1->getType() == EnemyType::BOUNCING) {
-                    e1->applyBouncingDamage(e2);
-                }
-                if (e2->getType() == EnemyType::BOUNCING) {
-                    e2->applyBouncingDamage(e1);
-                }
-            }
-        }
-    }
+    // Newest tick published by the simulation thread
+    snapshots->acquire();
+    RenderSnapshot& snap = snapshots->read();
 
-    // Update bullets
-    for (auto* bullet : bullets) {
-        bullet->update(deltaTime);
-    }
-
-    // Update skill manager
-    skillManager->update(deltaTime);
-
-    // Update mode manager (for level mode logic)
-    if (modeManager) {
-        modeManager->update(deltaTime);
-    }
-
-    // Process shield interactions (convex reflection, concave acceleration)
-    skillManager->processShieldInteractions(player, enemies);
-
-    // Check collisions
-    checkCollisions();
-
-    // Spawn enemies
-    spawnEnemies();
-
-    // Update time remaining for time challenge mode
-    // For LEVEL mode, only check timeout if timeRemaining > 0 (has time limit)
-    if (mode == GameMode::TIME_CHALLENGE) {
-        timeRemaining -= deltaTime;
-        if (timeRemaining <= 0) {
-            timeRemaining = 0;
-            state = GameState::GAME_OVER;
-            audio->playDeathSound();
-        }
-    } else if (mode == GameMode::LEVEL && timeRemaining > 0) {
-        // Only check timeout for levels that have a time limit
-        timeRemaining -= deltaTime;
-        if (timeRemaining <= 0) {
-            timeRemaining = 0;
-            state = GameState::GAME_OVER;
-            audio->playDeathSound();
-        }
-    }
-
-    // Check game over
-    if (player->getHealth() <= 0) {
+    if (snap.gameOver) {
         state = GameState::GAME_OVER;
-        audio->playDeathSound();
         // Stop background music on game over
         audio->playBackgroundMusic(false);
+        return;
     }
 
-    // Update game time
-    gameTime += deltaTime;
+    // How far this frame is past the last tick
+    renderAlpha = (float)((clockSeconds() - snap.tickTime) / snap.tickDt);
+    renderAlpha = fmaxf(0.0f, fminf(1.0f, renderAlpha));
+
+    // Camera follows where the player is drawn
+    Vector2 playerPos = snap.player.getRenderPosition(renderAlpha);
+    camera->update(playerPos, deltaTime);
+
+    // Sample input once per frame and hand it to the simulation; a full
+    // queue means the sim is stalled, so the frame's input is dropped
+    InputCommand command;
+    command.time = clockSeconds();
+    command.move = controls->getInputVector(playerPos);
+    command.skill = -1;
+    // Quick save: F5 or Esc, at most once per SAVE_COOLDOWN. The sim shows
+    // the popup and answers with a QUICK_SAVE event carrying the run
     timeSinceLastSave += deltaTime;
+    bool canSave = !hasRecentSave || timeSinceLastSave >= SAVE_COOLDOWN;
+    command.quickSave = canSave && (IsKeyPressed(KEY_F5) || IsKeyPressed(KEY_ESCAPE));
+    if (command.quickSave) {
+        timeSinceLastSave = 0;
+        hasRecentSave = true;
+    }
+    command.view = camera->getVisibleBounds();
+    inputQueue->push(command);
 
-    // Update UI
-    ui->update(deltaTime);
+    // Skill presses go through the queue too, stamped with this frame
+    auto sendSkill = [&](int skill) {
+        InputCommand press = command;
+        press.skill = skill;
+        press.quickSave = false;
+        inputQueue->push(press);
+    };
 
     // Check for skill button clicks (bottom-right corner)
     // CRITICAL FIX: Check ALL touch points, not just the first one
     // This allows using joystick (touch 0) and skills (touch 1) simultaneously
     int touchCount = GetTouchPointCount();
 
-    // Quick save: Check for F5 key or Esc key
-    int quickSaveKey = IsKeyPressed(KEY_F5) || IsKeyPressed(KEY_ESCAPE);
-    if (quickSaveKey && !hasRecentSave) {
-        quickSave();
-    }
-
     // Skill button area: bottom-right
     float buttonSize = 60.0f;
     float startX = SCREEN_WIDTH - 280.0f;
@@ -371,51 +389,7 @@ void Game::updatePlaying() {
             if (pos.x >= x && pos.x <= x + buttonSize &&
                 pos.y >= startY && pos.y <= startY + buttonSize) {
                 // Skill button clicked
-                SkillType skillType = (SkillType)i;
-                if (skillManager->canUseSkill(skillType)) {
-                    Vector2 facingDir = player->getFacingDirection();
-                    int playerHP = player->getHealth();
-
-                    if (skillType == SkillType::BLINK) {
-                        // Handle blink - move player
-                        float blinkDist = player->getSize() * 5.0f;
-                        Vector2 newPos = {
-                            player->getPosition().x + facingDir.x * blinkDist,
-                            player->getPosition().y + facingDir.y * blinkDist
-                        };
-                        // Clamp to world bounds
-                        if (newPos.x < player->getSize()) newPos.x = player->getSize();
-                        if (newPos.x > WORLD_WIDTH - player->getSize()) newPos.x = WORLD_WIDTH - player->getSize();
-                        if (newPos.y < player->getSize()) newPos.y = player->getSize();
-                        if (newPos.y > WORLD_HEIGHT - player->getSize()) newPos.y = WORLD_HEIGHT - player->getSize();
-                        player->setPosition(newPos);
-                        skillManager->useSkill(skillType, newPos, facingDir, player->getSize(), playerHP);
-                        audio->playBlinkSound();
-                    } else if (skillType == SkillType::SHOOT) {
-                        // Handle shoot - create bullet and consume HP
-                        int hpCost = 20;
-                        int currentHP = player->getHealth();
-                        if (currentHP > hpCost) {
-                            player->takeDamage(hpCost);
-                            int damage = hpCost * 3;
-                            Bullet* bullet = new Bullet(player->getPosition(), facingDir, damage, 0);
-                            bullets.push_back(bullet);
-                            skillManager->useSkill(skillType, player->getPosition(), facingDir, player->getSize(), currentHP);
-                            audio->playShootSound();
-                        }
-                    } else if (skillType == SkillType::SHIELD) {
-                        // Handle shield - set shield duration based on player level
-                        int playerLevel = player->getLevel();
-                        float shieldDuration = 1.0f + (playerLevel - 1) * 1.0f;  // 1-15 seconds
-                        if (shieldDuration > 15.0f) shieldDuration = 15.0f;
-                        skillManager->setShieldDuration(shieldDuration);
-                        skillManager->useSkill(skillType, player->getPosition(), facingDir, player->getSize(), playerHP);
-                        audio->playShieldSound();
-                    } else {
-                        skillManager->useSkill(skillType, player->getPosition(), facingDir, player->getSize(), playerHP);
-                        audio->playRotateSound();
-                    }
-                }
+                sendSkill(i);
                 break;  // Only handle one button click per touch point
             }
         }
@@ -428,48 +402,7 @@ void Game::updatePlaying() {
             float x = startX + i * spacing;
             if (pos.x >= x && pos.x <= x + buttonSize &&
                 pos.y >= startY && pos.y <= startY + buttonSize) {
-                // Skill button clicked
-                SkillType skillType = (SkillType)i;
-                if (skillManager->canUseSkill(skillType)) {
-                    Vector2 facingDir = player->getFacingDirection();
-                    int playerHP = player->getHealth();
-
-                    if (skillType == SkillType::BLINK) {
-                        float blinkDist = player->getSize() * 5.0f;
-                        Vector2 newPos = {
-                            player->getPosition().x + facingDir.x * blinkDist,
-                            player->getPosition().y + facingDir.y * blinkDist
-                        };
-                        if (newPos.x < player->getSize()) newPos.x = player->getSize();
-                        if (newPos.x > WORLD_WIDTH - player->getSize()) newPos.x = WORLD_WIDTH - player->getSize();
-                        if (newPos.y < player->getSize()) newPos.y = player->getSize();
-                        if (newPos.y > WORLD_HEIGHT - player->getSize()) newPos.y = WORLD_HEIGHT - player->getSize();
-                        player->setPosition(newPos);
-                        skillManager->useSkill(skillType, newPos, facingDir, player->getSize(), playerHP);
-                        audio->playBlinkSound();
-                    } else if (skillType == SkillType::SHOOT) {
-                        int hpCost = 20;
-                        int currentHP = player->getHealth();
-                        if (currentHP > hpCost) {
-                            player->takeDamage(hpCost);
-                            int damage = hpCost * 3;
-                            Bullet* bullet = new Bullet(player->getPosition(), facingDir, damage, 0);
-                            bullets.push_back(bullet);
-                            skillManager->useSkill(skillType, player->getPosition(), facingDir, player->getSize(), currentHP);
-                            audio->playShootSound();
-                        }
-                    } else if (skillType == SkillType::SHIELD) {
-                        int playerLevel = player->getLevel();
-                        float shieldDuration = 1.0f + (playerLevel - 1) * 1.0f;
-                        if (shieldDuration > 15.0f) shieldDuration = 15.0f;
-                        skillManager->setShieldDuration(shieldDuration);
-                        skillManager->useSkill(skillType, player->getPosition(), facingDir, player->getSize(), playerHP);
-                        audio->playShieldSound();
-                    } else {
-                        skillManager->useSkill(skillType, player->getPosition(), facingDir, player->getSize(), playerHP);
-                        audio->playRotateSound();
-                    }
-                }
+                sendSkill(i);
                 break;
             }
         }
@@ -487,6 +420,201 @@ void Game::updatePlaying() {
     }
 }
 
+void Game::startSimulation() {
+    // Input left over from before a pause is stale
+    InputCommand stale;
+    while (inputQueue->pop(stale)) {}
+    tickInput = {0, 0};
+    tickView = camera->getVisibleBounds();
+    runOver = false;
+
+    // Publish the current state so the first frame has something to draw
+    captureSnapshot(snapshots->write(), clockSeconds());
+    snapshots->publish();
+    snapshots->acquire();
+
+    simRunning = true;
+    simThread = std::thread(&Game::simulationLoop, this);
+}
+
+void Game::stopSimulation() {
+    simRunning = false;
+    if (simThread.joinable()) {
+        simThread.join();
+    }
+
+    // Keep the run so far on disk, a pause or quit may be all we get
+    if (!replaying && replay->getTickCount() > 0) {
+        replay->save(Replay::REPLAY_FILE_PATH);
+    }
+}
+
+void Game::simulationLoop() {
+    Profiler::setThreadName("sim");
+    const float tickDt = 1.0f / tickRate;
+    double simClock = clockSeconds();  // End of the last simulated tick
+
+    while (simRunning.load(std::memory_order_acquire) && !runOver) {
+        // After a long stall (app backgrounded, debugger) skip ahead
+        // instead of running every missed tick
+        double now = clockSeconds();
+        if (now - simClock > MAX_FRAME_TIME) {
+            simClock = now - MAX_FRAME_TIME;
+        }
+
+        int ticks = 0;
+        while (simClock + tickDt <= now && ticks < MAX_TICKS_PER_FRAME && !runOver) {
+            simClock += tickDt;
+            if (replaying) {
+                applyReplayInput();
+                if (runOver) break;  // End of the recording
+            } else {
+                applyInput(simClock);
+            }
+            sim->tick(tickDt, tickInput);
+            checkReplayTick();
+
+            // Sounds and unlocks are handled on the render thread; a full
+            // queue drops the event
+            for (const SimEvent& event : sim->getEvents()) {
+                simEvents->push(event);
+            }
+            sim->clearEvents();
+            if (sim->isOver()) runOver = true;
+            ticks++;
+        }
+
+        if (ticks > 0 || runOver) {
+            captureSnapshot(snapshots->write(), simClock);
+            snapshots->publish();
+        }
+
+        // Sleep until the next tick is due
+        double wait = simClock + tickDt - clockSeconds();
+        if (wait > 0 && !runOver) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+        }
+    }
+}
+
+void Game::applyInput(double until) {
+    // Commands sampled before this tick ends, oldest first
+    InputCommand command;
+    const InputCommand* next;
+    while ((next = inputQueue->peek()) != nullptr && next->time <= until) {
+        inputQueue->pop(command);
+        tickInput = Replay::quantize(command.move);  // As a replay will see it
+        tickView = command.view;
+        if (command.skill >= 0) {
+            replay->recordSkill(command.skill);
+            sim->activateSkill((SkillType)command.skill);
+        }
+        if (command.quickSave) {
+            // Stats and sound are the render thread's, see quickSave()
+            sim->particles->spawnTextPopup(sim->player->getPosition(), "GAME SAVED!", {100, 255, 100, 255});
+            simEvents->push({SimEventType::QUICK_SAVE, sim->player->getLevel(), sim->getScore(), sim->getGameTime()});
+        }
+    }
+}
+
+void Game::applyReplayInput() {
+    // Live input is ignored while a recording drives the sim, only the
+    // view is taken
+    InputCommand ignored;
+    while (inputQueue->pop(ignored)) {
+        tickView = ignored.view;
+    }
+
+    unsigned int tick = sim->getTickCount();
+    if (!replay->hasTick(tick)) {
+        runOver = true;
+        return;
+    }
+    tickInput = replay->getMove(tick);
+    int skill;
+    while ((skill = replay->popSkill(tick)) >= 0) {
+        sim->activateSkill((SkillType)skill);
+    }
+}
+
+void Game::checkReplayTick() {
+    if (stressing) return;  // Scenario runs aren't recorded
+    unsigned int tick = sim->getTickCount() - 1;  // tick() already counted it
+    unsigned int hash = sim->hashState();
+    if (!replaying) {
+        replay->recordTick(tickInput, hash);
+        return;
+    }
+    if (!replayDiverged && replay->hasTick(tick) && replay->getHash(tick) != hash) {
+        replayDiverged = true;
+        TraceLog(LOG_WARNING, TextFormat("REPLAY: diverged at tick %u (state %08x, recorded %08x)",
+                                         tick, hash, replay->getHash(tick)));
+    }
+}
+
+void Game::captureSnapshot(RenderSnapshot& snap, double tickTime) {
+    snap.tickTime = tickTime;
+    snap.tickDt = 1.0f / tickRate;
+    snap.gameOver = runOver;
+
+    // Buffers are reused, so after warm-up this only copies
+    snap.player = *sim->player;
+    snap.skills = *sim->skillManager;
+    snap.particles = *sim->particles;
+
+    // Only what the camera can see goes into the snapshot. Enemies come
+    // from the grid around the view, padded by the largest enemy, and are
+    // sorted back into spawn order so overlaps draw the same every frame
+    Rectangle view = padRect(tickView, CULL_MARGIN);
+    Rectangle enemyView = padRect(view, sim->enemyGrid->getMaxEnemySize() / 2.0f);
+    visibleEnemies.clear();
+    sim->enemyGrid->queryRect(enemyView, visibleEnemies);
+    std::sort(visibleEnemies.begin(), visibleEnemies.end(), [](const Enemy* a, const Enemy* b) {
+        return a->getId() < b->getId();
+    });
+    snap.enemies.clear();
+    float simTime = sim->getGameTime();
+    for (const Enemy* enemy : visibleEnemies) {
+        if (!enemy->isAlive()) continue;
+        Rectangle box = {enemy->getPosition().x - enemy->getSize() / 2.0f,
+                         enemy->getPosition().y - enemy->getSize() / 2.0f,
+                         (float)enemy->getSize(), (float)enemy->getSize()};
+        if (CheckCollisionRecs(box, view)) {
+            snap.enemies.push_back(enemy->getSprite(simTime));
+        }
+    }
+    snap.enemiesCulled = sim->enemies->count() - (int)snap.enemies.size();
+    snap.bulletsCulled = sim->bullets->getSprites(padRect(view, BulletPool::SIZE), snap.bullets);
+
+    snap.score = sim->getScore();
+    snap.timeRemaining = sim->getTimeRemaining();
+}
+
+void Game::handleSimEvents() {
+    SimEvent event;
+    while (simEvents->pop(event)) {
+        switch (event.type) {
+            case SimEventType::EAT: audio->playEatSound(event.value); break;
+            case SimEventType::LEVEL_UP: audio->playLevelUpSound(); break;
+            case SimEventType::DEATH: audio->playDeathSound(); break;
+            case SimEventType::HIT: audio->playHitSound(); break;
+            case SimEventType::BLINK: audio->playBlinkSound(); break;
+            case SimEventType::SHOOT: audio->playShootSound(); break;
+            case SimEventType::SHIELD: audio->playShieldSound(); break;
+            case SimEventType::ROTATE: audio->playRotateSound(); break;
+            case SimEventType::QUICK_SAVE: quickSave(event); break;
+            case SimEventType::LEVEL_COMPLETE: {
+                // Update user stats
+                User* user = userManager->getCurrentUser();
+                if (user && user->maxLevelUnlocked < event.value) {
+                    user->maxLevelUnlocked = event.value;
+                }
+                break;
+            }
+        }
+    }
+}
+
 void Game::updatePaused() {
     // Store current state before any state changes
     if (state != GameState::SETTINGS) {
@@ -550,6 +678,16 @@ void Game::updateSettings() {
                 state = previousState;
                 ui->resetTransition();
                 break;
+            case 5:  // Start / stop a trace capture
+                if (Profiler::isTracing()) {
+                    Profiler::stopTrace(Profiler::TRACE_FILE_PATH);
+                } else {
+                    Profiler::startTrace();
+                }
+                break;
+            case 6:  // Next built-in stress run
+                startNextStressPreset();
+                break;
         }
 
         ui->clearSelections();
@@ -629,9 +767,50 @@ void Game::drawMenu() {
 }
 
 void Game::drawPlaying() {
+    // Everything in the world comes from the last published tick
+    RenderSnapshot& snap = snapshots->read();
+
     // Apply camera for world rendering
     camera->apply();
 
+    {
+        PROFILE_ZONE(ProfileZone::DRAW_WORLD);
+        drawWorld(snap);
+    }
+
+    // Draw enemies (the snapshot only holds those in view), one quad batch
+    {
+        PROFILE_ZONE(ProfileZone::DRAW_ENEMIES);
+        EnemySprite::drawBatch(snap.enemies.data(), (int)snap.enemies.size(), renderAlpha);
+    }
+
+    // Draw bullets
+    {
+        PROFILE_ZONE(ProfileZone::DRAW_BULLETS);
+        for (const BulletSprite& bullet : snap.bullets) {
+            bullet.draw(renderAlpha);
+        }
+    }
+
+    // Draw particles, culled here: the snapshot copies them all
+    int particlesCulled = 0;
+    int particlesDrawn;
+    {
+        PROFILE_ZONE(ProfileZone::DRAW_PARTICLES);
+        particlesDrawn = snap.particles.draw(padRect(camera->getVisibleBounds(), CULL_MARGIN), particlesCulled);
+    }
+
+    cullStats = {(int)snap.enemies.size(), snap.enemiesCulled, (int)snap.bullets.size(), snap.bulletsCulled,
+                 particlesDrawn, particlesCulled};
+
+    // End camera mode (switch back to screen space for UI)
+    camera->end();
+
+    PROFILE_ZONE(ProfileZone::DRAW_HUD);
+    drawHud(snap);
+}
+
+void Game::drawWorld(RenderSnapshot& snap) {
     // Draw world map border (visible boundary around the play area)
     float borderWidth = 10.0f;
     Color borderColor = {255, 100, 100, 200};  // Red border
@@ -652,11 +831,15 @@ void Game::drawPlaying() {
     DrawRectangle(WORLD_WIDTH - cornerSize, WORLD_HEIGHT - borderWidth, cornerSize, borderWidth, borderOutlineColor);  // Bottom-right
     DrawRectangle(WORLD_WIDTH - borderWidth, WORLD_HEIGHT - cornerSize, borderWidth, cornerSize, borderOutlineColor);
 
-    // Draw blink effect (flash trail)
-    if (skillManager->getBlinkTimer() > 0) {
-        Vector2 blinkFrom = skillManager->getBlinkFromPos();
-        Vector2 blinkTo = skillManager->getBlinkToPos();
-        float blinkAlpha = skillManager->getBlinkTimer() / 0.3f;  // Fade out
+    Rectangle view = padRect(camera->getVisibleBounds(), CULL_MARGIN);
+
+    // Draw blink effect (flash trail), unless both ends are out of view
+    Vector2 blinkEnds[2] = {snap.skills.getBlinkFromPos(), snap.skills.getBlinkToPos()};
+    if (snap.skills.getBlinkTimer() > 0 &&
+        (CheckCollisionPointRec(blinkEnds[0], view) || CheckCollisionPointRec(blinkEnds[1], view))) {
+        Vector2 blinkFrom = snap.skills.getBlinkFromPos();
+        Vector2 blinkTo = snap.skills.getBlinkToPos();
+        float blinkAlpha = snap.skills.getBlinkTimer() / 0.3f;  // Fade out
 
         // Draw line from old position to new position
         DrawLineEx(blinkFrom, blinkTo, 10.0f, {255, 255, 100, (unsigned char)(200 * blinkAlpha)});
@@ -664,11 +847,11 @@ void Game::drawPlaying() {
         DrawCircleV(blinkTo, 40.0f, {255, 255, 150, (unsigned char)(150 * blinkAlpha)});
     }
 
-    // Draw shield if active
-    if (skillManager->isShieldActive()) {
-        Vector2 shieldPos = skillManager->getShieldPosition();
-        Vector2 shieldDir = skillManager->getShieldDirection();
-        int shieldLevel = skillManager->getShieldLevel();
+    // Draw shield if active and in view
+    if (snap.skills.isShieldActive() && CheckCollisionPointRec(snap.skills.getShieldPosition(), view)) {
+        Vector2 shieldPos = snap.skills.getShieldPosition();
+        Vector2 shieldDir = snap.skills.getShieldDirection();
+        int shieldLevel = snap.skills.getShieldLevel();
 
         // Draw arc shield (45° angle) - DrawCircleSector uses degrees
         float shieldRadius = 80.0f;
@@ -696,12 +879,12 @@ void Game::drawPlaying() {
     }
 
     // Draw rotate effect (spinning particles around player)
-    if (skillManager->isRotating()) {
-        Vector2 playerPos = player->getPosition();
-        float rotateTimer = skillManager->getRotateTimer();
+    if (snap.skills.isRotating()) {
+        Vector2 playerPos = snap.player.getRenderPosition(renderAlpha);
+        float rotateTimer = snap.skills.getRotateTimer();
         float rotation = GetTime() * 10.0f;  // Spinning animation
         int numParticles = 8;
-        float orbitRadius = player->getSize() + 30.0f;
+        float orbitRadius = snap.player.getSize() + 30.0f;
 
         for (int i = 0; i < numParticles; i++) {
             float angle = rotation + (i * 2.0f * PI / numParticles);
@@ -722,30 +905,19 @@ void Game::drawPlaying() {
     }
 
     // Draw player
-    player->draw();
-
-    // Draw enemies
-    for (auto* enemy : enemies) {
-        enemy->draw();
-    }
-
-    // Draw bullets
-    for (auto* bullet : bullets) {
-        bullet->draw();
-    }
-
-    // End camera mode (switch back to screen space for UI)
-    camera->end();
+    snap.player.draw(renderAlpha);
+}
 
+void Game::drawHud(RenderSnapshot& snap) {
     // Draw UI (in screen space)
-    ui->drawHUD(player);
-    ui->drawScore(score);
+    ui->drawHUD(&snap.player);
+    ui->drawScore(snap.score);
 
     if (mode == GameMode::TIME_CHALLENGE) {
-        ui->drawTimer(timeRemaining);
-    } else if (mode == GameMode::LEVEL && timeRemaining > 0) {
+        ui->drawTimer(snap.timeRemaining);
+    } else if (mode == GameMode::LEVEL && snap.timeRemaining > 0) {
         // Only draw timer for levels that have a time limit
-        ui->drawTimer(timeRemaining);
+        ui->drawTimer(snap.timeRemaining);
     }
 
     // Draw FPS counter (top-right corner, next to pause button)
@@ -754,11 +926,56 @@ void Game::drawPlaying() {
     sprintf(fpsText, "FPS: %d", fps);
     DrawText(fpsText, SCREEN_WIDTH - 160, 45, 16, {255, 255, 255, 200});
 
+    // Scenario and entity counts, to read scaling off the FPS counter.
+    // The snapshot only holds what is on screen, so add back the culled ones
+    if (stressing) {
+        DrawText(TextFormat("%s: %d enemies, %d bullets", scenario->name,
+                            (int)snap.enemies.size() + snap.enemiesCulled,
+                            (int)snap.bullets.size() + snap.bulletsCulled),
+                 20, SCREEN_HEIGHT - 30, 16, {255, 255, 255, 200});
+    }
+
     // Draw skill buttons
-    skillManager->draw();
+    snap.skills.draw();
 
     // Draw controls (includes pause button)
     controls->draw();
+
+#ifdef BLOCK_PROFILE
+    drawProfile();
+#endif
+}
+
+void Game::drawProfile() {
+    // avg / p99 of every zone over the last Profiler::HISTORY samples,
+    // under the FPS counter
+    int x = SCREEN_WIDTH - 260;
+    int y = 70;
+    for (int z = 0; z < (int)ProfileZone::COUNT; z++) {
+        ProfileZone zone = (ProfileZone)z;
+        ZoneStats stats = Profiler::getStats(zone);
+        if (stats.samples == 0) continue;
+        DrawText(TextFormat("%s: %.2f / %.2f ms", Profiler::getZoneName(zone), stats.avgMs, stats.p99Ms),
+                 x, y, 10, {255, 255, 255, 200});
+        y += 12;
+    }
+    // Drawn / culled by the view
+    DrawText(TextFormat("enemies: %d / %d culled", cullStats.enemiesDrawn, cullStats.enemiesCulled),
+             x, y, 10, {255, 255, 255, 200});
+    y += 12;
+    DrawText(TextFormat("bullets: %d / %d culled", cullStats.bulletsDrawn, cullStats.bulletsCulled),
+             x, y, 10, {255, 255, 255, 200});
+    y += 12;
+    DrawText(TextFormat("particles: %d / %d culled", cullStats.particlesDrawn, cullStats.particlesCulled),
+             x, y, 10, {255, 255, 255, 200});
+    y += 12;
+    if (AllocTracker::isEnabled()) {
+        // Red while playing: steady-state gameplay should not allocate
+        Color color = (state == GameState::PLAYING && frameAllocations > 0) ? Color{255, 80, 80, 255}
+                                                                            : Color{255, 255, 255, 200};
+        DrawText(TextFormat("allocs: %lld / frame (%lld bytes)", frameAllocations, frameAllocatedBytes),
+                 x, y, 10, color);
+    }
 }
 
 void Game::drawPaused() {
@@ -783,43 +1000,20 @@ void Game::drawLevelSelect() {
 void Game::startGame(GameMode newMode) {
     mode = newMode;
     state = GameState::PLAYING;
-    score = 0;
-    gameTime = 0;
-
-    // Initialize mode manager with new mode
-    if (modeManager) {
-        modeManager->init(mode);
-    }
-
-    // Reset player
-    delete player;
-    player = new Player();
-
-    // Clear enemies
-    for (auto* enemy : enemies) {
-        delete enemy;
-    }
-    enemies.clear();
-
-    // Set time based on mode
-    if (mode == GameMode::TIME_CHALLENGE) {
-        timeRemaining = 180.0f;  // 3 minutes
-    } else if (mode == GameMode::LEVEL) {
-        // CRITICAL FIX: Load time limit from level definition
-        // Level time limits: 0=no limit, 120=2min, 180=3min, 240=4min, 300=5min
-        switch (currentLevel) {
-            case 1: timeRemaining = 0; break;     // No limit
-            case 2: timeRemaining = 0; break;     // No limit
-            case 3: timeRemaining = 120; break;   // 2 minutes
-            case 4: timeRemaining = 0; break;     // No limit
-            case 5: timeRemaining = 180; break;   // 3 minutes
-            case 6: timeRemaining = 0; break;     // No limit
-            case 7: timeRemaining = 240; break;   // 4 minutes
-            case 8: timeRemaining = 0; break;     // No limit
-            case 9: timeRemaining = 300; break;   // 5 minutes
-            case 10: timeRemaining = 180; break;  // 3 minutes
-            default: timeRemaining = 0; break;    // No limit
-        }
+    renderAlpha = 0;
+
+    // Record the run from its first tick, or play the loaded one from
+    // the start ("Try Again" after a playback watches it again)
+    if (stressing) {
+        sim->startScenario(*scenario);
+        replay->begin(sim->getSeed(), (int)mode, currentLevel, tickRate);  // Stays empty
+    } else if (replaying) {
+        sim->start(mode, currentLevel, replay->getSeed());
+        replay->rewind();
+        replayDiverged = false;
+    } else {
+        sim->start(mode, currentLevel, newSessionSeed());
+        replay->begin(sim->getSeed(), (int)mode, currentLevel, tickRate);
     }
 
     audio->playButtonClickSound();
@@ -829,400 +1023,53 @@ void Game::startGame(GameMode newMode) {
 }
 
 void Game::resetGame() {
-    score = 0;
-    gameTime = 0;
+    renderAlpha = 0;
     currentLevel = 1;
 
-    // Reset player
-    if (player) {
-        delete player;
-        player = new Player();
-    }
-
-    // Clear enemies
-    for (auto* enemy : enemies) {
-        delete enemy;
-    }
-    enemies.clear();
-}
-
-void Game::spawnEnemies() {
-    // Keep a minimum number of enemies - 4x spawn rate
-    int minEnemies = 80 + (int)(gameTime / 2.5f);  // 4x base, 4x faster increase
-    minEnemies = (minEnemies > 400) ? 400 : minEnemies;  // Higher cap
-
-    if ((int)enemies.size() < minEnemies) {
-        // Spawn multiple enemies at once - 4x spawn count
-        int spawnCount = 12 + (int)(gameTime / 15.0f);  // 4x spawn groups
-        if (spawnCount > 40) spawnCount = 40;
-
-        for (int i = 0; i < spawnCount && (int)enemies.size() < minEnemies; i++) {
-            // Use player position directly for spawning
-            Vector2 playerPos = player->getPosition();
-
-            // Spawn new enemy around player with safe distance
-            int side = rand() % 4;
-            Vector2 pos;
-            float minSpawnDist = player->getSize() + 150.0f;  // Increased safe distance
-            float maxSpawnDist = minSpawnDist + 400.0f;     // Larger spawn area
-            float spawnDist = minSpawnDist + (float)(rand() % (int)(maxSpawnDist - minSpawnDist));
-
-            switch (side) {
-                case 0:  // Top
-                    pos = {playerPos.x + (float)(rand() % 400 - 200), playerPos.y - spawnDist};
-                    break;
-                case 1:  // Bottom
-                    pos = {playerPos.x + (float)(rand() % 400 - 200), playerPos.y + spawnDist};
-                    break;
-                case 2:  // Left
-                    pos = {playerPos.x - spawnDist, playerPos.y + (float)(rand() % 400 - 200)};
-                    break;
-                case 3:  // Right
-                    pos = {playerPos.x + spawnDist, playerPos.y + (float)(rand() % 400 - 200)};
-                    break;
-            }
-
-            // Clamp to world bounds
-            if (pos.x < 100) pos.x = 100;
-            if (pos.x > WORLD_WIDTH - 100) pos.x = (float)WORLD_WIDTH - 100;
-            if (pos.y < 100) pos.y = 100;
-            if (pos.y > WORLD_HEIGHT - 100) pos.y = (float)WORLD_HEIGHT - 100;
-
-            // Determine enemy type - all 4 types spawn randomly
-            EnemyType type = EnemyType::FLOATING;
-            int typeRoll = rand() % 100;
-
-            // All 4 types have roughly equal chance (25% each)
-            if (typeRoll < 25) {
-                type = EnemyType::FLOATING;
-            } else if (typeRoll < 50) {
-                type = EnemyType::CHASING;
-            } else if (typeRoll < 75) {
-                type = EnemyType::STATIONARY;
-            } else {
-                type = EnemyType::BOUNCING;
-            }
-
-            // Determine size - mix of food pellets and dangerous enemies
-            int playerSize = player->getSize();
-            int minEnemySize, maxEnemySize;
-
-            if (typeRoll < 30) {
-                // Food pellets - smaller than player
-                minEnemySize = 10;
-                maxEnemySize = playerSize - 5;
-                if (maxEnemySize < 10) maxEnemySize = 10;
-            } else {
-                // Dangerous enemies - can be larger or smaller
-                minEnemySize = playerSize - 15;
-                maxEnemySize = playerSize + 40;
-                if (minEnemySize < 15) minEnemySize = 15;
-            }
-
-            int size = minEnemySize + (rand() % (maxEnemySize - minEnemySize));
-
-            Enemy* enemy = new Enemy(type, pos, size);
-            enemies.push_back(enemy);
-        }
-    }
+    // Reset player and enemies
+    sim->clear();
+    replaying = false;
+    stressing = false;
 }
 
-void Game::checkCollisions() {
-    int playerSize = player->getSize();
-    Vector2 playerPos = player->getPosition();
-
-    // Check bullet-enemy collisions
-    auto bulletIt = bullets.begin();
-    while (bulletIt != bullets.end()) {
-        Bullet* bullet = *bulletIt;
-        if (!bullet->isAlive()) {
-            delete bullet;
-            bulletIt = bullets.erase(bulletIt);
-            continue;
-        }
-
-        Vector2 bulletPos = bullet->getPosition();
-        int bulletSize = bullet->getSize();
-
-        // Check collision with enemies (player bullets only, playerId >= 0)
-        bool bulletHit = false;
-        if (bullet->getPlayerId() >= 0) {
-            for (auto* enemy : enemies) {
-                if (!enemy->isAlive()) continue;
-
-                Vector2 enemyPos = enemy->getPosition();
-                int enemySize = enemy->getSize();
-
-                float dx = fabs(bulletPos.x - enemyPos.x);
-                float dy = fabs(bulletPos.y - enemyPos.y);
-                float combinedHalfSize = (bulletSize + enemySize) / 2.0f;
-
-                if (dx < combinedHalfSize && dy < combinedHalfSize) {
-                    // Bullet hit enemy
-                    int damage = bullet->getDamage();
-                    enemy->takeDamage(damage);
-                    bullet->kill();
-                    bulletHit = true;
-
-                    // Spawn hit effect
-                    particles->spawnPixelExplosion(bulletPos, {255, 255, 0, 255}, 5);
-                    particles->spawnDamageNumber(enemyPos, damage, true);
-
-                    if (!enemy->isAlive()) {
-                        score += damage * 5;
-                        player->addExperience(damage / 2);
-                    }
-                    break;
-                }
-            }
-        }
-        
-        // Check collision with player (enemy bullets only, playerId < 0)
-        if (!bulletHit && bullet->getPlayerId() < 0) {
-            float dx = fabs(bulletPos.x - playerPos.x);
-            float dy = fabs(bulletPos.y - playerPos.y);
-            float combinedHalfSize = (bulletSize + playerSize) / 2.0f;
-            
-            if (dx < combinedHalfSize && dy < combinedHalfSize) {
-                // Enemy bullet hit player
-                int damage = bullet->getDamage();
-                player->takeDamage(damage);
-                bullet->kill();
-                bulletHit = true;
-                
-                // Spawn hit effect
-                particles->spawnPixelExplosion(bulletPos, {255, 100, 100, 255}, 5);
-                particles->spawnDamageNumber(playerPos, damage, false);
-                audio->playHitSound();
-            }
-        }
-
-        if (!bulletHit) {
-            ++bulletIt;
-        }
-    }
-
-    // Clean up dead bullets
-    bulletIt = bullets.begin();
-    while (bulletIt != bullets.end()) {
-        if (!(*bulletIt)->isAlive()) {
-            delete *bulletIt;
-            bulletIt = bullets.erase(bulletIt);
-        } else {
-            ++bulletIt;
-        }
-    }
-
-    // Check shield-enemy collisions (shield blocks enemies)
-    if (skillManager->isShieldActive()) {
-        Vector2 shieldPos = skillManager->getShieldPosition();
-        Vector2 shieldDir = skillManager->getShieldDirection();
-        float shieldRadius = 80.0f;
-        float baseAngle = atan2f(shieldDir.y, shieldDir.x) * RAD2DEG;
-        
-        for (auto* enemy : enemies) {
-            if (!enemy->isAlive()) continue;
-            
-            Vector2 enemyPos = enemy->getPosition();
-            int enemySize = enemy->getSize();
-            
-            // Calculate distance from enemy to shield center
-            float dist = Vector2Length(enemyPos - shieldPos);
-            float combinedRadius = shieldRadius + enemySize / 2.0f;
-            
-            if (dist < combinedRadius) {
-                // Calculate angle from shield center to enemy
-                float angleToEnemy = atan2f(enemyPos.y - shieldPos.y, enemyPos.x - shieldPos.x) * RAD2DEG;
-                
-                // Normalize angles to -180 to 180 range for comparison
-                float angleDiff = angleToEnemy - baseAngle;
-                while (angleDiff > 180) angleDiff -= 360;
-                while (angleDiff < -180) angleDiff += 360;
-                
-                // Check if enemy is within 45 degree shield arc (±22.5 degrees)
-                if (fabs(angleDiff) <= 22.5f) {
-                    // Enemy hit the shield - push it back
-                    Vector2 pushDir = Vector2Normalize(enemyPos - shieldPos);
-                    enemy->setPosition(shieldPos + pushDir * (shieldRadius + enemySize / 2.0f + 5.0f));
-                    
-                    // Deal damage to enemy (shield level * 10)
-                    int shieldDamage = skillManager->getShieldLevel() * 10;
-                    enemy->takeDamage(shieldDamage);
-                    
-                    // Spawn hit effect
-                    particles->spawnPixelExplosion(enemyPos, {100, 255, 100, 255}, 5);
-                    particles->spawnDamageNumber(enemyPos, shieldDamage, true);
-                    
-                    // Play shield hit sound
-                    audio->playHitSound();
-                }
-            }
-        }
+bool Game::startReplay(const char* path) {
+    stopSimulation();
+    if (!replay->load(path)) {
+        replaying = false;
+        return false;
     }
 
-    // Check player-enemy collisions with rigid body physics
-    auto it = enemies.begin();
-    while (it != enemies.end()) {
-        Enemy* enemy = *it;
-        if (!enemy->isAlive()) {
-            delete enemy;
-            it = enemies.erase(it);
-            continue;
-        }
-
-        Vector2 enemyPos = enemy->getPosition();
-        int enemySize = enemy->getSize();
-
-        // AABB collision check
-        float dx = fabs(playerPos.x - enemyPos.x);
-        float dy = fabs(playerPos.y - enemyPos.y);
-        float combinedHalfSize = (playerSize + enemySize) / 2.0f;
-
-        if (dx < combinedHalfSize && dy < combinedHalfSize) {
-            // Check if player can eat enemy
-            bool canPlayerEat = (playerSize > enemySize) || 
-                                ((enemy->getType() == EnemyType::CHASING || 
-                                  enemy->getType() == EnemyType::FLOATING) && 
-                                 enemy->isVulnerable());
-            
-            // Check if enemy can eat player (only if enemy is significantly bigger)
-            bool canEnemyEat = (enemySize >= playerSize * 1.5f) && 
-                               (enemy->getType() != EnemyType::STATIONARY);
-            
-            if (canPlayerEat && !canEnemyEat) {
-                // Player eats enemy - grow by area
-                player->growByArea(enemySize);
-                
-                // Gain bullet skill if eating FLOATING enemy
-                if (enemy->getType() == EnemyType::FLOATING && !player->hasBulletSkill()) {
-                    player->enableBulletSkill();
-                    particles->spawnTextPopup(player->getPosition(), "BULLET SKILL!", {255, 255, 0, 255});
-                }
-                
-                // Experience gain
-                int expGained = enemy->getExpValue() * 2;
-                player->addExperience(expGained);
-                player->heal(5);
-                score += enemy->getExpValue() * 10;
-
-                // Check for level up
-                int oldLevel = player->getLevel();
-                if (player->getLevel() > oldLevel) {
-                    particles->spawnLevelUp(player->getPosition(), player->getLevel());
-                    audio->playLevelUpSound();
-                }
-
-                // Check for level completion and unlock next level
-                if (mode == GameMode::LEVEL) {
-                    LevelDefinition level = modeManager->getCurrentLevelDef();
-                    int currentLevel = player->getLevel();
-
-                    // Check if reached target score and level
-                    if (score >= level.targetScore && currentLevel >= level.targetLevel) {
-                        // Level complete! Unlock next level
-                        if (currentLevel < 10) {
-                            // Unlock next level
-                            modeManager->nextLevel();
-                            particles->spawnTextPopup(player->getPosition(),
-                                TextFormat("LEVEL %d COMPLETE!", currentLevel), {100, 255, 100, 255});
-                            audio->playLevelUpSound();
-
-                            // Update user stats
-                            User* user = userManager->getCurrentUser();
-                            if (user && user->maxLevelUnlocked < currentLevel) {
-                                user->maxLevelUnlocked = currentLevel;
-                            }
-                        }
-                    }
-                }
-
-                audio->playEatSound(player->getLevel());
+    TraceLog(LOG_INFO, TextFormat("REPLAY: playing %u ticks from %s", replay->getTickCount(), path));
+    replaying = true;
+    stressing = false;
+    currentLevel = replay->getLevel();
+    setTickRate(replay->getTickRate());
+    startGame((GameMode)replay->getMode());
+    return true;
+}
 
-                // Spawn particles
-                particles->spawnPixelExplosion(enemyPos, enemy->getColor(), 10);
-                particles->spawnTextPopup(enemyPos, "+SIZE", {100, 255, 100, 255});
+bool Game::startScenario(const char* path) {
+    Scenario loaded;
+    if (!loaded.load(path)) return false;
+    startScenario(loaded);
+    return true;
+}
 
-                enemy->kill();
-            } else if (canEnemyEat) {
-                // Enemy eats player - game over
-                player->takeDamage(player->getHealth());  // Kill player
-                particles->spawnPixelExplosion(playerPos, {255, 0, 0, 255}, 20);
-                audio->playDeathSound();
-            } else {
-                // Rigid body collision - both survive but bounce off each other
-                Vector2 normal = Vector2Normalize(playerPos - enemyPos);
-                player->applyRigidBodyCollision(enemy->getMass(), enemy->getVelocity(), normal);
-                Vector2 negNormal = (Vector2){-normal.x, -normal.y};
-                enemy->applyRigidBodyCollision(player->getMass(), player->getVelocity(), negNormal);
-                
-                // Small damage on collision
-                int damage = enemySize / 5;
-                player->takeDamage(damage);
-                if (damage > 0) {
-                    particles->spawnDamageNumber(playerPos, damage, false);
-                }
-            }
-        }
+void Game::startScenario(const Scenario& stress) {
+    stopSimulation();
+    TraceLog(LOG_INFO, TextFormat("SCENARIO: starting %s, %d enemies", stress.name,
+                                  stress.getTotalPopulation()));
+    *scenario = stress;
+    reserveSnapshots(stress.getTotalPopulation());
+    stressing = true;
+    replaying = false;
+    currentLevel = 1;
+    startGame(GameMode::ENDLESS);
+}
 
-        ++it;
-    }
-    
-    // Check enemy-enemy collisions (eating each other)
-    for (size_t i = 0; i < enemies.size(); i++) {
-        Enemy* e1 = enemies[i];
-        if (!e1->isAlive()) continue;
-        
-        for (size_t j = i + 1; j < enemies.size(); j++) {
-            Enemy* e2 = enemies[j];
-            if (!e2->isAlive()) continue;
-            
-            Vector2 pos1 = e1->getPosition();
-            Vector2 pos2 = e2->getPosition();
-            int size1 = e1->getSize();
-            int size2 = e2->getSize();
-            
-            float dx = fabs(pos1.x - pos2.x);
-            float dy = fabs(pos1.y - pos2.y);
-            float combinedHalfSize = (size1 + size2) / 2.0f;
-            
-            if (dx < combinedHalfSize && dy < combinedHalfSize) {
-                // BOUNCING types don't eat, they just deal damage
-                if (e1->getType() == EnemyType::BOUNCING || e2->getType() == EnemyType::BOUNCING) {
-                    // Already handled in update with applyBouncingDamage
-                    continue;
-                }
-                
-                // Check for vulnerable enemies (CHASING/FLOATING with <30% health)
-                bool e1Vulnerable = (e1->getType() == EnemyType::CHASING || e1->getType() == EnemyType::FLOATING) 
-                                    && e1->isVulnerable();
-                bool e2Vulnerable = (e2->getType() == EnemyType::CHASING || e2->getType() == EnemyType::FLOATING) 
-                                    && e2->isVulnerable();
-                
-                // Check if one can eat the other
-                if ((size1 > size2 || e2Vulnerable) && !(e1->getType() == EnemyType::STATIONARY && size1 < size2)) {
-                    // e1 eats e2 (STATIONARY can eat if bigger, but not if smaller)
-                    e1->growByArea(size2);
-                    e2->takeDamage(e2->getHealth());
-                    particles->spawnPixelExplosion(pos2, e2->getColor(), 8);
-                    particles->spawnTextPopup(pos2, "EATEN", {255, 100, 100, 255});
-                } else if ((size2 > size1 || e1Vulnerable) && !(e2->getType() == EnemyType::STATIONARY && size2 < size1)) {
-                    // e2 eats e1
-                    e2->growByArea(size1);
-                    e1->takeDamage(e1->getHealth());
-                    particles->spawnPixelExplosion(pos1, e1->getColor(), 8);
-                    particles->spawnTextPopup(pos1, "EATEN", {255, 100, 100, 255});
-                }
-                // If sizes are similar and neither is vulnerable, rigid body collision handles it
-            }
-        }
-    }
-    
-    // Process STATIONARY enemies eating bullets
-    for (auto* enemy : enemies) {
-        if (enemy->isAlive() && enemy->getType() == EnemyType::STATIONARY) {
-            enemy->tryEatBullet(bullets);
-        }
-    }
+void Game::startNextStressPreset() {
+    startScenario(Scenario::stress(STRESS_PRESETS[nextStressPreset]));
+    nextStressPreset = (nextStressPreset + 1) % STRESS_PRESET_COUNT;
 }
 
 // Note: Vector2Length and Vector2Normalize are defined as inline functions in game.h
@@ -1324,26 +1171,14 @@ void Game::drawNameInput() {
     ui->drawNameInput(nameInputBuffer);
 }
 
-void Game::quickSave() {
-    // Quick save during gameplay
-    const float SAVE_COOLDOWN = 2.0f;  // Seconds between saves
-
-    // Check if enough time passed since last save
-    if (timeSinceLastSave < SAVE_COOLDOWN) {
-        // Update user stats with current game progress
-        User* user = userManager->getCurrentUser();
-        if (user) {
-            userManager->updateStats(mode, score, gameTime, player->getLevel());
-        }
-
-        // Reset save timer
-        timeSinceLastSave = 0;
-        hasRecentSave = true;
-
-        // Show save notification
-        particles->spawnTextPopup(player->getPosition(), "GAME SAVED!", {100, 255, 100, 255});
-        audio->playButtonClickSound();
-
-        TraceLog(LOG_INFO, "Game saved successfully");
+void Game::quickSave(const SimEvent& event) {
+    // Update user stats with the progress the sim reported; the cooldown
+    // was applied when the save was requested
+    User* user = userManager->getCurrentUser();
+    if (user) {
+        userManager->updateStats(mode, event.score, event.time, event.value);
     }
+    audio->playButtonClickSound();
+
+    TraceLog(LOG_INFO, "Game saved successfully");
 }
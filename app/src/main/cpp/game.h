@@ -2,7 +2,11 @@
 #define GAME_H
 
 #include "raylib.h"
+#include "random.h"
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <thread>
 #include <vector>
 
 namespace BlockEater {
@@ -11,6 +15,7 @@ namespace BlockEater {
 constexpr int SCREEN_WIDTH = 1280;
 constexpr int SCREEN_HEIGHT = 720;
 constexpr int TARGET_FPS = 60;
+constexpr int DEFAULT_TICK_RATE = 60;  // Simulation ticks per second
 
 // World dimensions (4x screen size for larger map)
 constexpr int WORLD_WIDTH = 5120;
@@ -75,10 +80,38 @@ class AudioManager;
 class ControlSystem;
 class AssetManager;
 class GameCamera;
-class Bullet;
+class BulletPool;
+struct BulletHit;
 class SkillManager;
 class UserManager;
 class GameModeManager;
+class EnemyStore;
+class SpatialHash;
+class BulletGrid;
+struct ContactStripe;
+struct Contact;
+struct OverlapBatch;
+struct RenderSnapshot;
+class SnapshotBuffer;
+class InputQueue;
+class JobSystem;
+class Replay;
+struct Scenario;
+class Simulation;
+struct SimEvent;
+class SimEventQueue;
+struct EnemyCommandBuffer;
+enum class SkillType;
+
+// What view culling kept and dropped in one frame, for profiling
+struct CullStats {
+    int enemiesDrawn;
+    int enemiesCulled;
+    int bulletsDrawn;
+    int bulletsCulled;
+    int particlesDrawn;
+    int particlesCulled;
+};
 
 // Main Game class
 class Game {
@@ -95,43 +128,82 @@ public:
     // Getters
     GameState getState() const { return state; }
     GameMode getMode() const { return mode; }
-    int getScore() const { return score; }
+    int getScore() const;
     float getDeltaTime() const { return deltaTime; }
+    int getTickRate() const { return tickRate; }
+    bool isReplaying() const { return replaying; }
+    const CullStats& getCullStats() const { return cullStats; }  // Last drawn frame
 
     // Setters
     void setState(GameState s) { state = s; }
     void setMode(GameMode m) { mode = m; }
-    void addScore(int s) { score += s; }
+    void setTickRate(int hz);
+
+    // Plays a recorded run back (input, seed, mode and level from the
+    // file); false if the file can't be read
+    bool startReplay(const char* path);
+
+    // Stress run held at a scenario's populations (see scenario.h); the
+    // file variant is false if the file can't be read
+    bool startScenario(const char* path);
+    void startScenario(const Scenario& stress);
+    void startNextStressPreset();  // STRESS_PRESETS in turn, from the settings screen
 
     // Game objects
-    Player* player;
-    std::vector<Enemy*> enemies;
-    std::vector<Bullet*> bullets;
-    ParticleSystem* particles;
+    Simulation* sim;  // The world; owned by the sim thread while PLAYING
     UIManager* ui;
     AudioManager* audio;
     ControlSystem* controls;
     AssetManager* assets;
     GameCamera* camera;
-    SkillManager* skillManager;
     UserManager* userManager;
-    GameModeManager* modeManager;
 
 private:
     GameState state;
     GameState previousState;
     GameMode mode;
     ControlMode controlMode;
-    int score;
     int currentLevel;
-    float timeRemaining;
     float deltaTime;
-    float gameTime;
+
+    // Fixed-step simulation, on its own thread while PLAYING
+    static constexpr float MAX_FRAME_TIME = 0.25f;  // The sim never falls further behind
+    static constexpr int MAX_TICKS_PER_FRAME = 8;   // Ticks between two snapshots
+    static constexpr float CULL_MARGIN = 128.0f;    // View padding for camera lag and snapshot age
+    int tickRate;
+    float renderAlpha;       // Blend between the previous and current tick
+    Vector2 tickInput;       // Latest movement input (sim thread)
+    Rectangle tickView;      // Latest camera view (sim thread), snapshots are culled to it
+    std::vector<Enemy*> visibleEnemies;  // Sim thread scratch for snapshot culling
+    CullStats cullStats;     // Render thread
+    bool runOver;            // Set by the sim thread when the round ends
+    SnapshotBuffer* snapshots;  // Sim -> render
+    InputQueue* inputQueue;     // Render -> sim
+    SimEventQueue* simEvents;   // Sim -> render (sounds, unlocks)
+    Replay* replay;             // This run's input, or the run being played back
+    bool replaying;
+    bool replayDiverged;        // Reported once per playback
+    Scenario* scenario;         // Populations of the stress run being played
+    bool stressing;             // Runs start from scenario instead of the spawn curve
+    int nextStressPreset;
+    std::thread simThread;
+    std::atomic<bool> simRunning;
+    long long frameAllocations;    // Heap allocations during the last frame, both threads
+    long long frameAllocatedBytes; // (BLOCK_TRACK_ALLOC builds only)
     Texture2D backgroundTexture;  // Space background texture
     char nameInputBuffer[64];  // User name input buffer
 
     void updateMenu();
     void updatePlaying();
+    void startSimulation();
+    void stopSimulation();
+    void simulationLoop();  // Sim thread body
+    void applyInput(double until);
+    void applyReplayInput();
+    void checkReplayTick();  // Records or verifies the tick just simulated
+    void handleSimEvents();
+    void captureSnapshot(RenderSnapshot& snap, double tickTime);
+    void reserveSnapshots(int enemyCount);  // Capture buffers for that many enemies, sim stopped
     void updatePaused();
     void updateGameOver();
     void updateLevelSelect();
@@ -141,19 +213,21 @@ private:
 
     void drawMenu();
     void drawPlaying();
+    void drawWorld(RenderSnapshot& snap);  // Border, skill effects and player
+    void drawHud(RenderSnapshot& snap);
+    void drawProfile();  // Per-zone timings, drawn with BLOCK_PROFILE
     void drawPaused();
     void drawGameOver();
     void drawLevelSelect();
     void drawUserMenu();
     void drawNameInput();
 
-    void spawnEnemies();
-    void checkCollisions();
     void drawBackground();
     void startGame(GameMode newMode);
     void resetGame();
-    void quickSave();  // Quick save during gameplay
-    float timeSinceLastSave;  // Time since last save
+    static constexpr float SAVE_COOLDOWN = 2.0f;  // Seconds between quick saves
+    void quickSave(const SimEvent& event);  // Stats of a QUICK_SAVE event (render thread)
+    float timeSinceLastSave;  // Time since last save (render thread)
     bool hasRecentSave;  // Track if game was recently saved (for save spam prevention)
 };
 
@@ -0,0 +1,52 @@
+#include "raylib.h"
+#include <cstdarg>
+#include <cstdio>
+
+// The few raylib utilities the simulation core calls, for builds that
+// don't link raylib (block_sim). Same behaviour as raylib's own: log
+// lines below the trace level are dropped, TextFormat rotates through a
+// handful of static buffers.
+
+namespace {
+
+int logLevel = LOG_WARNING;  // Per-tick debug logging would drown the numbers
+
+const int TEXTFORMAT_BUFFERS = 4;
+const int TEXTFORMAT_LENGTH = 1024;
+
+} // namespace
+
+void SetTraceLogLevel(int level) {
+    logLevel = level;
+}
+
+void TraceLog(int level, const char* text, ...) {
+    if (level < logLevel) return;
+
+    const char* prefix = "INFO: ";
+    if (level == LOG_WARNING) prefix = "WARNING: ";
+    else if (level == LOG_ERROR) prefix = "ERROR: ";
+    else if (level == LOG_FATAL) prefix = "FATAL: ";
+    else if (level < LOG_INFO) prefix = "DEBUG: ";
+
+    va_list args;
+    va_start(args, text);
+    fputs(prefix, stderr);
+    vfprintf(stderr, text, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+const char* TextFormat(const char* text, ...) {
+    static char buffers[TEXTFORMAT_BUFFERS][TEXTFORMAT_LENGTH];
+    static int index = 0;
+
+    char* buffer = buffers[index];
+    index = (index + 1) % TEXTFORMAT_BUFFERS;
+
+    va_list args;
+    va_start(args, text);
+    vsnprintf(buffer, TEXTFORMAT_LENGTH, text, args);
+    va_end(args);
+    return buffer;
+}
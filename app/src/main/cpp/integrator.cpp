@@ -0,0 +1,184 @@
+#include "integrator.h"
+#include "game.h"
+#include "simd.h"
+#include <cmath>
+
+namespace BlockEater {
+
+namespace {
+
+#ifdef BLOCK_SIMD
+using namespace simd;
+
+constexpr int BODIES_PER_VECTOR = LANES / 2;
+
+// World size repeated as x, y pairs
+const float WORLD_LIMIT[8] = {
+    (float)WORLD_WIDTH, (float)WORLD_HEIGHT, (float)WORLD_WIDTH, (float)WORLD_HEIGHT,
+    (float)WORLD_WIDTH, (float)WORLD_HEIGHT, (float)WORLD_WIDTH, (float)WORLD_HEIGHT
+};
+
+// Half sizes of the next bodies, each repeated for its x and y lane
+inline VFloat loadHalfSizes(const int* size) {
+    float half[LANES];
+    for (int k = 0; k < BODIES_PER_VECTOR; k++) {
+        half[2 * k] = half[2 * k + 1] = (float)(size[k] / 2);
+    }
+    return vload(half);
+}
+#endif
+
+} // namespace
+
+void integrateBodies(Vector2* pos, Vector2* vel, Vector2* acc, int count, float dt, float friction) {
+    int i = 0;
+
+#ifdef BLOCK_SIMD
+    float* p = reinterpret_cast<float*>(pos);
+    float* v = reinterpret_cast<float*>(vel);
+    float* a = reinterpret_cast<float*>(acc);
+    VFloat vdt = vset1(dt);
+    VFloat vfriction = vset1(friction);
+    VFloat zero = vset1(0.0f);
+    for (; i + BODIES_PER_VECTOR <= count; i += BODIES_PER_VECTOR) {
+        int f = i * 2;
+        VFloat nv = vmul(vadd(vload(v + f), vmul(vload(a + f), vdt)), vfriction);
+        vstore(v + f, nv);
+        vstore(p + f, vadd(vload(p + f), vmul(nv, vdt)));
+        vstore(a + f, zero);
+    }
+#endif
+
+    for (; i < count; i++) {
+        vel[i].x = (vel[i].x + acc[i].x * dt) * friction;
+        vel[i].y = (vel[i].y + acc[i].y * dt) * friction;
+        pos[i].x += vel[i].x * dt;
+        pos[i].y += vel[i].y * dt;
+        acc[i] = {0, 0};
+    }
+}
+
+void advanceBodies(Vector2* pos, Vector2* prev, const Vector2* vel, float* life, int count, float dt) {
+    int i = 0;
+
+#ifdef BLOCK_SIMD
+    float* p = reinterpret_cast<float*>(pos);
+    float* pp = reinterpret_cast<float*>(prev);
+    const float* v = reinterpret_cast<const float*>(vel);
+    VFloat vdt = vset1(dt);
+    for (; i + BODIES_PER_VECTOR <= count; i += BODIES_PER_VECTOR) {
+        int f = i * 2;
+        VFloat cur = vload(p + f);
+        vstore(pp + f, cur);
+        vstore(p + f, vadd(cur, vmul(vload(v + f), vdt)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        prev[i] = pos[i];
+        pos[i].x += vel[i].x * dt;
+        pos[i].y += vel[i].y * dt;
+    }
+
+    // Lifetimes are one float per body
+    i = 0;
+#ifdef BLOCK_SIMD
+    for (; i + LANES <= count; i += LANES) {
+        vstore(life + i, vsub(vload(life + i), vdt));
+    }
+#endif
+    for (; i < count; i++) {
+        life[i] -= dt;
+    }
+}
+
+void clampBodiesToWorld(Vector2* pos, Vector2* vel, const int* size, int count) {
+    int i = 0;
+
+#ifdef BLOCK_SIMD
+    float* p = reinterpret_cast<float*>(pos);
+    float* v = reinterpret_cast<float*>(vel);
+    VFloat limit = vload(WORLD_LIMIT);
+    VFloat halfSpeed = vset1(0.5f);
+    for (; i + BODIES_PER_VECTOR <= count; i += BODIES_PER_VECTOR) {
+        int f = i * 2;
+        VFloat lo = loadHalfSizes(size + i);
+        VFloat hi = vsub(limit, lo);
+        VFloat x = vload(p + f);
+        VFloat vx = vload(v + f);
+
+        VMask below = vlt(x, lo);
+        VMask above = vgt(x, hi);
+        VFloat away = vmul(vabs(vx), halfSpeed);
+        vstore(v + f, vselect(below, away, vselect(above, vneg(away), vx)));
+        vstore(p + f, vmin(vmax(x, lo), hi));
+    }
+#endif
+
+    for (; i < count; i++) {
+        int halfSize = size[i] / 2;
+        if (pos[i].x < halfSize) {
+            pos[i].x = halfSize;
+            vel[i].x = fabsf(vel[i].x) * 0.5f;
+        }
+        if (pos[i].x > WORLD_WIDTH - halfSize) {
+            pos[i].x = WORLD_WIDTH - halfSize;
+            vel[i].x = -fabsf(vel[i].x) * 0.5f;
+        }
+        if (pos[i].y < halfSize) {
+            pos[i].y = halfSize;
+            vel[i].y = fabsf(vel[i].y) * 0.5f;
+        }
+        if (pos[i].y > WORLD_HEIGHT - halfSize) {
+            pos[i].y = WORLD_HEIGHT - halfSize;
+            vel[i].y = -fabsf(vel[i].y) * 0.5f;
+        }
+    }
+}
+
+void reflectBodiesOffWorld(Vector2* pos, Vector2* vel, const int* size, int count) {
+    int i = 0;
+
+#ifdef BLOCK_SIMD
+    float* p = reinterpret_cast<float*>(pos);
+    float* v = reinterpret_cast<float*>(vel);
+    VFloat limit = vload(WORLD_LIMIT);
+    for (; i + BODIES_PER_VECTOR <= count; i += BODIES_PER_VECTOR) {
+        int f = i * 2;
+        VFloat lo = loadHalfSizes(size + i);
+        VFloat hi = vsub(limit, lo);
+        VFloat x = vload(p + f);
+        VFloat vx = vload(v + f);
+
+        VMask outside = vor(vlt(x, lo), vgt(x, hi));
+        vstore(v + f, vselect(outside, vneg(vx), vx));
+        vstore(p + f, vmin(vmax(x, lo), hi));
+    }
+#endif
+
+    for (; i < count; i++) {
+        int halfSize = size[i] / 2;
+        if (pos[i].x < halfSize || pos[i].x > WORLD_WIDTH - halfSize) {
+            vel[i].x = -vel[i].x;
+            pos[i].x = fmaxf(halfSize, fminf(WORLD_WIDTH - halfSize, pos[i].x));
+        }
+        if (pos[i].y < halfSize || pos[i].y > WORLD_HEIGHT - halfSize) {
+            vel[i].y = -vel[i].y;
+            pos[i].y = fmaxf(halfSize, fminf(WORLD_HEIGHT - halfSize, pos[i].y));
+        }
+    }
+}
+
+const char* getSimdBackendName() {
+#if defined(BLOCK_SIMD_NEON)
+    return "NEON";
+#elif defined(BLOCK_SIMD_AVX)
+    return "AVX";
+#elif defined(BLOCK_SIMD_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace BlockEater
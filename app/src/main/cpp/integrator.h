@@ -0,0 +1,32 @@
+#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+
+#include "raylib.h"
+
+namespace BlockEater {
+
+// Physics kernels over packed Vector2 columns (x and y interleaved, so the
+// same lane math applies to both axes). Vectorized with NEON on arm64,
+// SSE2 on x86-64 and AVX when the compiler targets it; scalar when no SIMD
+// is available or the build defines BLOCK_NO_SIMD. The scalar loop also
+// handles the tail that doesn't fill a whole vector; both paths give the
+// same bits (built without FMA contraction, checked by block_simd_check).
+
+// vel = (vel + acc * dt) * friction, pos += vel * dt, acc = 0
+void integrateBodies(Vector2* pos, Vector2* vel, Vector2* acc, int count, float dt, float friction);
+
+// prev = pos, pos += vel * dt, life -= dt
+void advanceBodies(Vector2* pos, Vector2* prev, const Vector2* vel, float* life, int count, float dt);
+
+// World bounds by half of each body's size:
+// clamp stops at the wall and keeps half the speed pointing away from it,
+// reflect flips the velocity on the axis that left the world (BOUNCING)
+void clampBodiesToWorld(Vector2* pos, Vector2* vel, const int* size, int count);
+void reflectBodiesOffWorld(Vector2* pos, Vector2* vel, const int* size, int count);
+
+// Name of the compiled kernel set ("NEON", "SSE2", "AVX" or "scalar")
+const char* getSimdBackendName();
+
+} // namespace BlockEater
+
+#endif // INTEGRATOR_H
@@ -0,0 +1,141 @@
+#include "jobs.h"
+
+namespace BlockEater {
+
+void JobSystem::WorkQueue::pushBack(const Job& job) {
+    unsigned int mask = (unsigned int)ring.size() - 1;
+    if (size == ring.size()) {
+        std::vector<Job> grown(ring.size() * 2);
+        for (unsigned int i = 0; i < size; i++) {
+            grown[i] = ring[(head + i) & mask];
+        }
+        ring.swap(grown);
+        head = 0;
+        mask = (unsigned int)ring.size() - 1;
+    }
+    ring[(head + size) & mask] = job;
+    size++;
+}
+
+bool JobSystem::WorkQueue::popBack(Job& job) {
+    if (size == 0) return false;
+    size--;
+    job = ring[(head + size) & ((unsigned int)ring.size() - 1)];
+    return true;
+}
+
+bool JobSystem::WorkQueue::popFront(Job& job) {
+    if (size == 0) return false;
+    job = ring[head];
+    head = (head + 1) & ((unsigned int)ring.size() - 1);
+    size--;
+    return true;
+}
+
+JobSystem::JobSystem(int workerCount)
+    : queued(0)
+    , quit(false)
+{
+    if (workerCount < 0) {
+        int hardware = (int)std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    for (int i = 0; i <= workerCount; i++) {
+        queues.push_back(new WorkQueue());
+    }
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        quit = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (auto* queue : queues) {
+        delete queue;
+    }
+}
+
+void JobSystem::run(Loop& loop, int chunks) {
+    // Deal the chunks round-robin, the caller's queue included;
+    // stealing evens out whatever the deal got wrong
+    queued.fetch_add(chunks, std::memory_order_relaxed);
+    int queueCount = (int)queues.size();
+    for (int q = 0; q < queueCount; q++) {
+        std::lock_guard<std::mutex> lock(queues[q]->mutex);
+        for (int c = q; c < chunks; c += queueCount) {
+            queues[q]->pushBack({&loop, c});
+        }
+    }
+
+    // Taking the lock orders this against a worker about to sleep
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_all();
+
+    // Help until every chunk of this loop has finished
+    Job job;
+    while (loop.remaining.load(std::memory_order_acquire) > 0) {
+        if (popOwn(0, job) || steal(0, job)) {
+            execute(job);
+        } else {
+            std::this_thread::yield();  // Last chunks are running elsewhere
+        }
+    }
+}
+
+void JobSystem::workerLoop(int self) {
+    Job job;
+    for (;;) {
+        if (popOwn(self, job) || steal(self, job)) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return quit || queued.load(std::memory_order_relaxed) > 0; });
+        if (quit) return;
+    }
+}
+
+bool JobSystem::popOwn(int self, Job& job) {
+    // Newest first: its data is most likely still in this core's cache
+    WorkQueue& queue = *queues[self];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.popBack(job)) return false;
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::steal(int self, Job& job) {
+    // Oldest first from the others, starting with the next queue over
+    int queueCount = (int)queues.size();
+    for (int i = 1; i < queueCount; i++) {
+        WorkQueue& queue = *queues[(self + i) % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.popFront(job)) continue;
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(const Job& job) {
+    Loop& loop = *job.loop;
+    int begin = job.chunk * loop.grainSize;
+    int end = begin + loop.grainSize < loop.count ? begin + loop.grainSize : loop.count;
+    loop.body(loop.context, begin, end, job.chunk);
+
+    // Last touch of the loop: the caller may return as soon as this drops to 0
+    loop.remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+} // namespace BlockEater
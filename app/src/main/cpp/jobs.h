@@ -0,0 +1,112 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BlockEater {
+
+// Small work-stealing thread pool for data-parallel loops.
+// Every worker owns a double-ended queue: it pops its own work from the
+// back and, when empty, steals from the front of another worker's queue, so a fast core
+// that finishes early takes over chunks queued for a slow one (big.LITTLE).
+// The thread calling parallelFor owns a deque too and works until its loop
+// is done. Only one thread may call parallelFor at a time (the sim thread).
+class JobSystem {
+public:
+    // -1: one worker per hardware thread besides the caller;
+    // 0: no workers, loops run inline on the caller (serial reference)
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+
+    int getWorkerCount() const { return (int)workers.size(); }
+
+    // Calls fn(begin, end, chunk) for consecutive ranges of at most
+    // grainSize items covering [0, count), and returns once all ran.
+    // Chunk numbers depend only on count and grainSize, never on which
+    // thread ran the range, so per-chunk output merges deterministically.
+    template <typename Fn>
+    void parallelFor(int count, int grainSize, Fn fn) {
+        if (count <= 0) return;
+        if (grainSize < 1) grainSize = 1;
+        int chunks = (count + grainSize - 1) / grainSize;
+        if (chunks == 1 || workers.empty()) {
+            for (int c = 0; c < chunks; c++) {
+                int begin = c * grainSize;
+                int end = begin + grainSize < count ? begin + grainSize : count;
+                fn(begin, end, c);
+            }
+            return;
+        }
+
+        Loop loop;
+        loop.body = &invoke<Fn>;
+        loop.context = &fn;
+        loop.count = count;
+        loop.grainSize = grainSize;
+        loop.remaining.store(chunks, std::memory_order_relaxed);
+        run(loop, chunks);
+    }
+
+    // Chunks parallelFor will split count items into
+    static int chunkCount(int count, int grainSize) {
+        if (count <= 0) return 0;
+        if (grainSize < 1) grainSize = 1;
+        return (count + grainSize - 1) / grainSize;
+    }
+
+private:
+    struct Loop {
+        void (*body)(void* context, int begin, int end, int chunk);
+        void* context;
+        int count;
+        int grainSize;
+        std::atomic<int> remaining;  // Chunks not finished yet
+    };
+
+    struct Job {
+        Loop* loop;
+        int chunk;
+    };
+
+    // Ring of jobs, guarded by mutex. Grows (doubling) only past its
+    // high-water mark, so dealing loops doesn't allocate once warmed up
+    struct WorkQueue {
+        static constexpr unsigned int INITIAL_CAPACITY = 64;  // Power of two
+
+        std::mutex mutex;
+        std::vector<Job> ring;
+        unsigned int head = 0;  // Oldest job
+        unsigned int size = 0;
+
+        WorkQueue() : ring(INITIAL_CAPACITY) {}
+        void pushBack(const Job& job);
+        bool popBack(Job& job);
+        bool popFront(Job& job);
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<WorkQueue*> queues;  // [0] is the caller's, [i + 1] is worker i's
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queued;         // Jobs pushed and not yet taken
+    bool quit;
+
+    template <typename Fn>
+    static void invoke(void* context, int begin, int end, int chunk) {
+        (*static_cast<Fn*>(context))(begin, end, chunk);
+    }
+
+    void run(Loop& loop, int chunks);
+    void workerLoop(int self);
+    bool popOwn(int self, Job& job);
+    bool steal(int self, Job& job);
+    void execute(const Job& job);
+};
+
+} // namespace BlockEater
+
+#endif // JOBS_H
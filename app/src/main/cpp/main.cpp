@@ -1,5 +1,7 @@
 #include "game.h"
+#include "profiler.h"
 #include "raylib.h"
+#include <cstring>
 
 using namespace BlockEater;
 
@@ -23,8 +25,28 @@ int main(int argc, char* argv[]) {
     // Create and run game
     Game* game = new Game();
     game->init();
+
+    // --replay <file> plays a recorded run back; --scenario <file> starts
+    // a stress run (see scenario.h); --trace <file> captures a profiler
+    // trace of the whole session (needs BLOCK_PROFILE)
+    const char* tracePath = Profiler::TRACE_FILE_PATH;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--replay") == 0) {
+            game->startReplay(argv[i + 1]);
+        } else if (strcmp(argv[i], "--scenario") == 0) {
+            game->startScenario(argv[i + 1]);
+        } else if (strcmp(argv[i], "--trace") == 0) {
+            tracePath = argv[i + 1];
+            Profiler::startTrace();
+        }
+    }
     game->run();
     game->shutdown();
+
+    // Also keeps a capture started from the settings screen
+    if (Profiler::isTracing()) {
+        Profiler::stopTrace(tracePath);
+    }
     delete game;
 
     // Cleanup
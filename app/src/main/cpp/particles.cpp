@@ -1,150 +1,119 @@
 #include "particles.h"
 #include <cstdio>
-#include <cstdlib>
 #include <cmath>
+#include <cstring>
 
 namespace BlockEater {
 
-// Particle base class
-Particle::Particle(ParticleType type, Vector2 pos, Color col, float lifeTime)
-    : position(pos)
-    , velocity{0, 0}
-    , color(col)
-    , lifeTime(lifeTime)
-    , maxLifeTime(lifeTime)
-    , type(type)
-    , size(5.0f)
-    , alpha(1.0f)
-{
-}
-
-Particle::~Particle() {
-}
-
-void Particle::update(float dt) {
-    position.x += velocity.x * dt;
-    position.y += velocity.y * dt;
-    lifeTime -= dt;
-    alpha = lifeTime / maxLifeTime;
-}
-
-void Particle::draw() {
-    Color c = color;
-    c.a = (unsigned char)(alpha * 255);
-
-    if (type == ParticleType::PIXEL) {
-        DrawRectangle((int)position.x, (int)position.y, (int)size, (int)size, c);
-    } else if (type == ParticleType::CIRCLE) {
-        DrawCircleV(position, size, c);
-    }
-}
-
-// Text Particle
-TextParticle::TextParticle(Vector2 pos, const char* text, Color col)
-    : Particle(ParticleType::TEXT, pos, col, 1.5f)
-    , text(text)
-    , fontSize(20)
-{
-    velocity.y = -50.0f;  // Float upward
-}
-
-void TextParticle::draw() {
-    Color c = color;
-    c.a = (unsigned char)(alpha * 255);
-    DrawText(text.c_str(), (int)position.x, (int)position.y, fontSize, c);
-}
-
-// Pixel Particle
-PixelParticle::PixelParticle(Vector2 pos, Color col, Vector2 vel)
-    : Particle(ParticleType::PIXEL, pos, col, 0.8f + (float)(rand() % 100) / 500.0f)
-{
-    velocity = vel;
-    size = 3.0f + (float)(rand() % 100) / 50.0f;
-}
-
-// Level Up Particle
-LevelUpParticle::LevelUpParticle(Vector2 pos, int level)
-    : Particle(ParticleType::LEVEL_UP, pos, {255, 215, 0, 255}, 2.0f)
-    , level(level)
-    , scale(1.0f)
-    , rotation(0.0f)
-{
-    size = 50.0f;
-}
-
-void LevelUpParticle::update(float dt) {
-    Particle::update(dt);
-    scale += dt * 2.0f;
-    rotation += dt * 180.0f;
-}
-
-void LevelUpParticle::draw() {
-    Color c = color;
-    c.a = (unsigned char)(alpha * 255);
-
-    char text[32];
-    sprintf(text, "LEVEL %d!", level);
-
-    int fontSize = (int)(30 * scale);
-    int textWidth = MeasureText(text, fontSize);
-
-    // Draw with rotation effect (simulated by oscillating position)
-    float wave = sinf(rotation * DEG2RAD) * 5.0f;
-    DrawText(text, (int)(position.x - textWidth/2 + wave), (int)position.y, fontSize, c);
-
-    // Draw star burst
-    for (int i = 0; i < 8; i++) {
-        float angle = (i * 45 + rotation) * DEG2RAD;
-        float dist = 30 * scale;
-        Vector2 starPos = {
-            position.x + cosf(angle) * dist,
-            position.y + sinf(angle) * dist
-        };
-        DrawCircleV(starPos, 3 * scale, c);
-    }
+// Particle columns
+void ParticleColumns::push(Vector2 pos, Vector2 vel, float life, Color col) {
+    position.push_back(pos);
+    velocity.push_back(vel);
+    lifeTime.push_back(life);
+    maxLifeTime.push_back(life);
+    color.push_back(col);
+}
+
+void ParticleColumns::reserve(int rows) {
+    position.reserve(rows);
+    velocity.reserve(rows);
+    lifeTime.reserve(rows);
+    maxLifeTime.reserve(rows);
+    color.reserve(rows);
+}
+
+void ParticleColumns::swapRemove(int i) {
+    int last = count() - 1;
+    position[i] = position[last];
+    velocity[i] = velocity[last];
+    lifeTime[i] = lifeTime[last];
+    maxLifeTime[i] = maxLifeTime[last];
+    color[i] = color[last];
+    position.pop_back();
+    velocity.pop_back();
+    lifeTime.pop_back();
+    maxLifeTime.pop_back();
+    color.pop_back();
+}
+
+void ParticleColumns::clear() {
+    position.clear();
+    velocity.clear();
+    lifeTime.clear();
+    maxLifeTime.clear();
+    color.clear();
 }
 
 // Particle System
 ParticleSystem::ParticleSystem() {
+    pixels.reserve(MAX_PIXELS);
+    pixelSize.reserve(MAX_PIXELS);
+    texts.reserve(MAX_TEXTS);
+    textValue.reserve(MAX_TEXTS);
+    levelUps.reserve(MAX_LEVEL_UPS);
+    levelUpLevel.reserve(MAX_LEVEL_UPS);
 }
 
 ParticleSystem::~ParticleSystem() {
-    for (auto* p : particles) {
-        delete p;
+}
+
+void ParticleSystem::integrate(ParticleColumns& cols, float dt) {
+    int n = cols.count();
+    Vector2* pos = cols.position.data();
+    const Vector2* vel = cols.velocity.data();
+    float* life = cols.lifeTime.data();
+    for (int i = 0; i < n; i++) {
+        pos[i].x += vel[i].x * dt;
+        pos[i].y += vel[i].y * dt;
+        life[i] -= dt;
     }
 }
 
 void ParticleSystem::update(float dt) {
-    for (auto* p : particles) {
-        p->update(dt);
-    }
+    integrate(pixels, dt);
+    integrate(texts, dt);
+    integrate(levelUps, dt);
     cleanup();
 }
 
-void ParticleSystem::draw() {
-    for (auto* p : particles) {
-        p->draw();
-    }
+int ParticleSystem::getParticleCount() const {
+    return pixels.count() + texts.count() + levelUps.count();
 }
 
 void ParticleSystem::spawnPixelExplosion(Vector2 pos, Color color, int count) {
+    if (count > MAX_PIXELS - pixels.count()) {
+        count = MAX_PIXELS - pixels.count();
+    }
     for (int i = 0; i < count; i++) {
-        float angle = ((float)(rand() % 360)) * DEG2RAD;
-        float speed = 100.0f + (float)(rand() % 200);
+        uint32_t r[4];
+        random.fill(r, 4);
+        float angle = (float)Random::toInt(r[0], 360) * DEG2RAD;
+        float speed = 100.0f + (float)Random::toInt(r[1], 200);
         Vector2 vel = {
             cosf(angle) * speed,
             sinf(angle) * speed
         };
-        particles.push_back(new PixelParticle(pos, color, vel));
+        float life = 0.8f + (float)Random::toInt(r[2], 100) / 500.0f;
+        float size = 3.0f + (float)Random::toInt(r[3], 100) / 50.0f;
+        pixels.push(pos, vel, life, color);
+        pixelSize.push_back(size);
     }
 }
 
 void ParticleSystem::spawnTextPopup(Vector2 pos, const char* text, Color color) {
-    particles.push_back(new TextParticle(pos, text, color));
+    if (texts.count() >= MAX_TEXTS) return;
+    texts.push(pos, {0, -50.0f}, 1.5f, color);  // Float upward
+    PopupText popup;
+    strncpy(popup.value, text, sizeof(popup.value) - 1);
+    popup.value[sizeof(popup.value) - 1] = '\0';
+    textValue.push_back(popup);
 }
 
 void ParticleSystem::spawnLevelUp(Vector2 pos, int level) {
-    particles.push_back(new LevelUpParticle(pos, level));
+    if (levelUps.count() < MAX_LEVEL_UPS) {
+        levelUps.push(pos, {0, 0}, 2.0f, {255, 215, 0, 255});
+        levelUpLevel.push_back(level);
+    }
 
     // Add pixel explosion
     spawnPixelExplosion(pos, {255, 215, 0, 255}, 30);
@@ -158,7 +127,7 @@ void ParticleSystem::spawnDamageNumber(Vector2 pos, int damage, bool isCrit) {
         sprintf(text, "-%d", damage);
     }
     Color color = isCrit ? Color{255, 50, 50, 255} : Color{255, 150, 150, 255};
-    particles.push_back(new TextParticle(pos, text, color));
+    spawnTextPopup(pos, text, color);
 }
 
 void ParticleSystem::spawnExplosion(Vector2 pos, Color color, float size) {
@@ -167,14 +136,24 @@ void ParticleSystem::spawnExplosion(Vector2 pos, Color color, float size) {
 }
 
 void ParticleSystem::cleanup() {
-    auto it = particles.begin();
-    while (it != particles.end()) {
-        if (!(*it)->isAlive()) {
-            delete *it;
-            it = particles.erase(it);
-        } else {
-            ++it;
-        }
+    // Swap-remove expired rows, walking backwards so moved rows were already checked
+    for (int i = pixels.count() - 1; i >= 0; i--) {
+        if (pixels.lifeTime[i] > 0) continue;
+        pixels.swapRemove(i);
+        pixelSize[i] = pixelSize.back();
+        pixelSize.pop_back();
+    }
+    for (int i = texts.count() - 1; i >= 0; i--) {
+        if (texts.lifeTime[i] > 0) continue;
+        texts.swapRemove(i);
+        textValue[i] = textValue.back();
+        textValue.pop_back();
+    }
+    for (int i = levelUps.count() - 1; i >= 0; i--) {
+        if (levelUps.lifeTime[i] > 0) continue;
+        levelUps.swapRemove(i);
+        levelUpLevel[i] = levelUpLevel.back();
+        levelUpLevel.pop_back();
     }
 }
 
@@ -3,8 +3,8 @@
 
 #include "raylib.h"
 #include "game.h"
+#include "random.h"
 #include <vector>
-#include <string>
 
 namespace BlockEater {
 
@@ -17,52 +17,19 @@ enum class ParticleType {
     EXPLOSION      // Explosion effect
 };
 
-class Particle {
-public:
-    Particle(ParticleType type, Vector2 pos, Color col, float lifeTime);
-    virtual ~Particle();
-
-    virtual void update(float dt);
-    virtual void draw();
-
-    bool isAlive() const { return lifeTime > 0; }
-
-protected:
-    Vector2 position;
-    Vector2 velocity;
-    Color color;
-    float lifeTime;
-    float maxLifeTime;
-    ParticleType type;
-    float size;
-    float alpha;
-};
-
-class TextParticle : public Particle {
-public:
-    TextParticle(Vector2 pos, const char* text, Color col);
-    void draw() override;
-
-private:
-    std::string text;
-    int fontSize;
-};
-
-class PixelParticle : public Particle {
-public:
-    PixelParticle(Vector2 pos, Color col, Vector2 vel);
-};
-
-class LevelUpParticle : public Particle {
-public:
-    LevelUpParticle(Vector2 pos, int level);
-    void update(float dt) override;
-    void draw() override;
-
-private:
-    int level;
-    float scale;
-    float rotation;
+// Components shared by every particle archetype, one column per component
+struct ParticleColumns {
+    std::vector<Vector2> position;
+    std::vector<Vector2> velocity;
+    std::vector<float> lifeTime;
+    std::vector<float> maxLifeTime;
+    std::vector<Color> color;
+
+    int count() const { return (int)position.size(); }
+    void reserve(int rows);
+    void push(Vector2 pos, Vector2 vel, float life, Color col);
+    void swapRemove(int i);
+    void clear();
 };
 
 class ParticleSystem {
@@ -71,7 +38,9 @@ public:
     ~ParticleSystem();
 
     void update(float dt);
-    void draw();
+    // Particles inside view only (level-up effects always); returns how
+    // many were drawn, adds the skipped ones to culled
+    int draw(Rectangle view, int& culled);
 
     void spawnPixelExplosion(Vector2 pos, Color color, int count);
     void spawnTextPopup(Vector2 pos, const char* text, Color color);
@@ -79,9 +48,33 @@ public:
     void spawnDamageNumber(Vector2 pos, int damage, bool isCrit);
     void spawnExplosion(Vector2 pos, Color color, float size);
 
-private:
-    std::vector<Particle*> particles;
+    int getParticleCount() const;
+    void setSeed(uint64_t seed) { random = Random(seed, RandomStream::PARTICLES); }
 
+private:
+    // Popup text inline in its row, so popups (and snapshot copies of
+    // them) never allocate; longer text is cut off
+    struct PopupText {
+        char value[24];
+    };
+
+    // Rows per archetype, reserved up front. Spawns into a full table are
+    // dropped, so the columns never grow while playing
+    static constexpr int MAX_PIXELS = 4096;
+    static constexpr int MAX_TEXTS = 512;
+    static constexpr int MAX_LEVEL_UPS = 16;
+
+    // One table per archetype; extra per-archetype columns sit alongside
+    ParticleColumns pixels;
+    std::vector<float> pixelSize;
+    ParticleColumns texts;
+    std::vector<PopupText> textValue;
+    ParticleColumns levelUps;
+    std::vector<int> levelUpLevel;  // Scale and spin are derived from age
+
+    Random random;
+
+    static void integrate(ParticleColumns& cols, float dt);
     void cleanup();
 };
 
@@ -9,6 +9,7 @@ namespace BlockEater {
 
 Player::Player()
     : position{WORLD_WIDTH / 2.0f, WORLD_HEIGHT / 2.0f}
+    , previousPosition{WORLD_WIDTH / 2.0f, WORLD_HEIGHT / 2.0f}
     , velocity{0, 0}
     , acceleration{0, 0}
     , facingDirection{1, 0}
@@ -48,7 +49,7 @@ void Player::updateEnergy() {
     kineticEnergy = 0.5f * mass * speedSq;
 }
 
-void Player::update(float dt, std::vector<Bullet*>& bullets) {
+void Player::update(float dt, BulletPool& bullets) {
     // Update invincibility
     if (invincibleTime > 0) {
         invincibleTime -= dt;
@@ -195,72 +196,6 @@ void Player::applyRigidBodyCollision(float otherMass, Vector2 otherVelocity,
     velocity.y += impulse.y / m1;
 }
 
-void Player::draw() {
-    // Blink when invincible
-    if (invincibleTime > 0 && fmodf(invincibleTime, 0.1f) < 0.05f) {
-        return;
-    }
-
-    Color c = getColor();
-
-    // Draw shadow
-    DrawRectangle(
-        (int)position.x - size/2 + 4,
-        (int)position.y - size/2 + 4,
-        size, size,
-        {0, 0, 0, 100}
-    );
-
-    // Draw main block
-    DrawRectangle(
-        (int)position.x - size/2,
-        (int)position.y - size/2,
-        size, size,
-        c
-    );
-
-    // Draw pixel border
-    DrawRectangleLines(
-        (int)position.x - size/2,
-        (int)position.y - size/2,
-        size, size,
-        {255, 255, 255, 180}
-    );
-
-    // Draw highlight
-    int highlightSize = size / 3;
-    DrawRectangle(
-        (int)position.x - size/2 + 2,
-        (int)position.y - size/2 + 2,
-        highlightSize, highlightSize,
-        {255, 255, 255, 100}
-    );
-
-    // Draw level indicator
-    char levelText[16];
-    sprintf(levelText, "L%d", level);
-    int fontSize = 10;
-    int textWidth = MeasureText(levelText, fontSize);
-    DrawText(levelText,
-             (int)position.x - textWidth/2,
-             (int)position.y - fontSize/2,
-             fontSize, WHITE);
-             
-    // Draw bullet skill indicator
-    if (bulletSkillEnabled) {
-        DrawCircleLines((int)position.x, (int)position.y, size/2 + 5, {255, 255, 0, 150});
-    }
-    
-    // Draw velocity indicator (small arrow)
-    if (Vector2Length(velocity) > 10.0f) {
-        Vector2 dir = Vector2Normalize(velocity);
-        int arrowLen = size / 2 + 10;
-        Vector2 end = {position.x + dir.x * arrowLen, position.y + dir.y * arrowLen};
-        DrawLine((int)position.x, (int)position.y, (int)end.x, (int)end.y, 
-                 {255, 255, 255, 150});
-    }
-}
-
 void Player::takeDamage(int damage) {
     if (invincibleTime > 0) return;
 
@@ -326,11 +261,10 @@ void Player::setSize(int newSize) {
     if (health < 1) health = 1;
 }
 
-void Player::tryShootBullet(std::vector<Bullet*>& bullets) {
+void Player::tryShootBullet(BulletPool& bullets) {
     if (!bulletSkillEnabled || bulletCooldown > 0) return;
     
-    Bullet* bullet = new Bullet(position, facingDirection, size, 0);
-    bullets.push_back(bullet);
+    bullets.spawn(position, facingDirection, size, 0);
     
     // Recoil
     Vector2 recoil = {-facingDirection.x * 50.0f, -facingDirection.y * 50.0f};
@@ -8,7 +8,7 @@
 namespace BlockEater {
 
 // Forward declaration
-class Bullet;
+class BulletPool;
 
 // Player level stats - only affects combat stats, not size
 struct LevelStats {
@@ -45,8 +45,8 @@ public:
     Player();
     ~Player();
 
-    void update(float dt, std::vector<Bullet*>& bullets);
-    void draw();
+    void update(float dt, BulletPool& bullets);
+    void draw(float alpha);  // alpha blends the previous and current tick
 
     // Physics-based movement - joystick applies force
     void applyJoystickInput(Vector2 inputDirection);
@@ -71,10 +71,17 @@ public:
     Color getColor() const { return LEVEL_STATS[level - 1].color; }
     float getMoveSpeed() const { return LEVEL_STATS[level - 1].moveSpeed; }
     Vector2 getFacingDirection() const { return facingDirection; }
+    Vector2 getRenderPosition(float alpha) const {
+        return previousPosition + (position - previousPosition) * alpha;
+    }
     
     // Setters
     void setPosition(Vector2 pos) { position = pos; }
     void setVelocity(Vector2 vel) { velocity = vel; }
+
+    // Render interpolation
+    void savePreviousPosition() { previousPosition = position; }  // Start of every tick
+    void resetInterpolation() { previousPosition = position; }    // After a teleport
     
     // Size management
     void growByArea(int eatenSize);
@@ -83,7 +90,7 @@ public:
     // Bullet skill
     bool hasBulletSkill() const { return bulletSkillEnabled; }
     void enableBulletSkill() { bulletSkillEnabled = true; }
-    void tryShootBullet(std::vector<Bullet*>& bullets);
+    void tryShootBullet(BulletPool& bullets);
 
     // Physics
     void applyForce(Vector2 force);
@@ -91,6 +98,7 @@ public:
 
 private:
     Vector2 position;
+    Vector2 previousPosition;  // At the start of the tick
     Vector2 velocity;
     Vector2 acceleration;
     Vector2 facingDirection;
@@ -0,0 +1,208 @@
+#include "profiler.h"
+#include "raylib.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace BlockEater {
+
+namespace {
+
+const char* const ZONE_NAMES[] = {
+    "tick",
+    "player",
+    "enemy AI",
+    "physics",
+    "bullets",
+    "skills",
+    "collisions",
+    "spawn",
+    "particles",
+    "input",
+    "ui",
+    "draw background",
+    "draw world",
+    "draw enemies",
+    "draw bullets",
+    "draw particles",
+    "draw hud",
+    "frame",
+};
+static_assert(sizeof(ZONE_NAMES) / sizeof(ZONE_NAMES[0]) == (int)ProfileZone::COUNT,
+              "One name per profile zone");
+
+// Trace capture. Any thread may add events: a slot is claimed with
+// fetch_add, and stopTrace waits for writers still inside addTraceEvent
+// before reading the buffer.
+struct TraceEvent {
+    uint64_t start;
+    uint32_t duration;  // Nanoseconds
+    uint16_t zone;
+    uint16_t thread;
+};
+
+const int MAX_TRACE_THREADS = 16;
+
+std::vector<TraceEvent> traceEvents;  // Sized by startTrace
+std::atomic<bool> tracing(false);
+std::atomic<int> traceWriters(0);
+std::atomic<int> traceClaimed(0);
+uint64_t traceStart = 0;
+
+std::atomic<int> threadCount(0);
+const char* threadNames[MAX_TRACE_THREADS];
+thread_local int threadId = -1;
+
+int currentThread() {
+    if (threadId < 0) {
+        threadId = threadCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return threadId;
+}
+
+void addTraceEvent(ProfileZone zone, uint64_t start, uint64_t duration) {
+    traceWriters.fetch_add(1, std::memory_order_seq_cst);
+    if (tracing.load(std::memory_order_seq_cst)) {
+        int slot = traceClaimed.fetch_add(1, std::memory_order_relaxed);
+        if (slot < Profiler::TRACE_CAPACITY) {
+            traceEvents[slot] = {start, duration > UINT32_MAX ? UINT32_MAX : (uint32_t)duration,
+                                 (uint16_t)zone, (uint16_t)currentThread()};
+        }
+    }
+    traceWriters.fetch_sub(1, std::memory_order_release);
+}
+
+} // namespace
+
+std::atomic<uint32_t> Profiler::samples[(int)ProfileZone::COUNT][Profiler::HISTORY];
+std::atomic<uint32_t> Profiler::written[(int)ProfileZone::COUNT];
+
+uint64_t Profiler::now() {
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Profiler::record(ProfileZone zone, uint64_t start, uint64_t end) {
+    uint64_t nanoseconds = end - start;
+    if (tracing.load(std::memory_order_relaxed)) {
+        addTraceEvent(zone, start, nanoseconds);
+    }
+
+    // Only the zone's own thread writes, so load + store is enough
+    int z = (int)zone;
+    uint32_t n = written[z].load(std::memory_order_relaxed);
+    samples[z][n % HISTORY].store(nanoseconds > UINT32_MAX ? UINT32_MAX : (uint32_t)nanoseconds,
+                                  std::memory_order_relaxed);
+    written[z].store(n + 1, std::memory_order_release);
+}
+
+ZoneStats Profiler::getStats(ProfileZone zone) {
+    int z = (int)zone;
+    uint32_t n = written[z].load(std::memory_order_acquire);
+    int count = (n < (uint32_t)HISTORY) ? (int)n : HISTORY;
+
+    ZoneStats stats = {count, 0, 0, 0};
+    if (count == 0) return stats;
+
+    // A sample overwritten while copying just belongs to a newer frame
+    uint32_t copy[HISTORY];
+    uint64_t total = 0;
+    for (int i = 0; i < count; i++) {
+        copy[i] = samples[z][i].load(std::memory_order_relaxed);
+        total += copy[i];
+    }
+    int p99 = (count * 99 + 99) / 100 - 1;  // Nearest rank
+    std::nth_element(copy, copy + p99, copy + count);
+    stats.p99Ms = copy[p99] / 1e6f;
+    stats.minMs = *std::min_element(copy, copy + count) / 1e6f;
+    stats.avgMs = (float)total / count / 1e6f;
+    return stats;
+}
+
+const char* Profiler::getZoneName(ProfileZone zone) {
+    return ZONE_NAMES[(int)zone];
+}
+
+void Profiler::reset() {
+    for (int z = 0; z < (int)ProfileZone::COUNT; z++) {
+        written[z].store(0, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::startTrace() {
+#ifndef BLOCK_PROFILE
+    TraceLog(LOG_WARNING, "PROFILER: built without BLOCK_PROFILE, the trace will be empty");
+#endif
+    if (tracing.load()) return;
+    traceEvents.resize(TRACE_CAPACITY);
+    traceClaimed.store(0);
+    traceStart = now();
+    tracing.store(true);
+    TraceLog(LOG_INFO, "PROFILER: trace started");
+}
+
+bool Profiler::stopTrace(const char* path) {
+    if (!tracing.load()) return false;
+    tracing.store(false);
+    while (traceWriters.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+
+    int claimed = traceClaimed.load();
+    int count = (claimed < TRACE_CAPACITY) ? claimed : TRACE_CAPACITY;
+    bool ok = false;
+    FILE* file = fopen(path, "w");
+    if (file) {
+        // Complete ("X") events in microseconds, one pid, a track per thread
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+        const char* separator = "\n";
+        int threads = threadCount.load();
+        if (threads > MAX_TRACE_THREADS) threads = MAX_TRACE_THREADS;
+        for (int t = 0; t < threads; t++) {
+            const char* name = threadNames[t] ? threadNames[t] : "thread";
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                          "\"args\":{\"name\":\"%s\"}}", separator, t, name);
+            separator = ",\n";
+        }
+        for (int i = 0; i < count; i++) {
+            const TraceEvent& event = traceEvents[i];
+            // Zones already open when the capture started are clipped to its start
+            double ts = (event.start > traceStart) ? (double)(event.start - traceStart) / 1000.0 : 0.0;
+            const char* category = (event.zone < (int)ProfileZone::INPUT) ? "sim" : "render";
+            fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                          "\"pid\":1,\"tid\":%d}",
+                    separator, ZONE_NAMES[event.zone], category, ts, event.duration / 1000.0, event.thread);
+            separator = ",\n";
+        }
+        fprintf(file, "\n]}\n");
+        ok = fclose(file) == 0;
+    }
+
+    if (ok) {
+        TraceLog(LOG_INFO, TextFormat("PROFILER: wrote %d trace events to %s", count, path));
+    } else {
+        TraceLog(LOG_ERROR, TextFormat("PROFILER: cannot write trace to %s", path));
+    }
+    if (claimed > TRACE_CAPACITY) {
+        TraceLog(LOG_WARNING, TextFormat("PROFILER: trace full, %d events dropped", claimed - TRACE_CAPACITY));
+    }
+
+    // Don't hold on to the buffer between captures
+    std::vector<TraceEvent>().swap(traceEvents);
+    return ok;
+}
+
+bool Profiler::isTracing() {
+    return tracing.load(std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const char* name) {
+    int t = currentThread();
+    if (t < MAX_TRACE_THREADS) {
+        threadNames[t] = name;
+    }
+}
+
+} // namespace BlockEater
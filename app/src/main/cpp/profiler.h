@@ -0,0 +1,113 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace BlockEater {
+
+// Timed phases of a frame. Sim zones are sampled once per tick on the sim
+// thread, render zones once per frame on the render thread; every zone
+// has exactly one writer thread.
+enum class ProfileZone {
+    // Sim thread
+    TICK,            // All of Simulation::tick
+    PLAYER,
+    ENEMY_AI,
+    PHYSICS,
+    BULLETS,
+    SKILLS,          // Skills, modes and shield interactions
+    COLLISIONS,
+    SPAWN,
+    PARTICLES,
+    // Render thread
+    INPUT,           // Controls and the state's update (input sampling)
+    UI,              // UIManager::update and sim events
+    DRAW_BACKGROUND,
+    DRAW_WORLD,      // Border, skill effects and player
+    DRAW_ENEMIES,
+    DRAW_BULLETS,
+    DRAW_PARTICLES,
+    DRAW_HUD,
+    FRAME,           // Game::update and Game::draw together
+    COUNT
+};
+
+// Summary of a zone's recent history, in milliseconds
+struct ZoneStats {
+    int samples;
+    float minMs;
+    float avgMs;
+    float p99Ms;
+};
+
+// Keeps the last HISTORY samples of every zone in a ring buffer. Recording
+// is a couple of relaxed atomic stores, reading may happen on any thread.
+// Zones are only compiled in with BLOCK_PROFILE (see PROFILE_ZONE).
+//
+// A trace capture additionally logs every zone with its start time and
+// thread, and writes them as Chrome Trace Event JSON (chrome://tracing,
+// ui.perfetto.dev) when stopped.
+class Profiler {
+public:
+    static constexpr int HISTORY = 240;  // 4 seconds at 60 Hz
+    static constexpr int TRACE_CAPACITY = 1 << 18;  // Events per capture, later ones are dropped
+    static constexpr char TRACE_FILE_PATH[] = "trace.json";
+
+    static void record(ProfileZone zone, uint64_t start, uint64_t end);
+    static ZoneStats getStats(ProfileZone zone);
+    static const char* getZoneName(ProfileZone zone);
+    static void reset();  // While no zone is being recorded
+
+    // Trace capture; stopTrace writes the file, false if it can't
+    static void startTrace();
+    static bool stopTrace(const char* path);
+    static bool isTracing();
+    static void setThreadName(const char* name);  // Label of the calling thread in traces
+
+    // Innermost zone open on the calling thread, -1 outside every zone
+    static int getActiveZone() { return activeZone; }
+
+    static uint64_t now();  // Monotonic nanoseconds
+
+private:
+    static inline thread_local int activeZone = -1;
+    friend class ProfileScope;
+
+    static std::atomic<uint32_t> samples[(int)ProfileZone::COUNT][HISTORY];  // Nanoseconds, capped at ~4 s
+    static std::atomic<uint32_t> written[(int)ProfileZone::COUNT];           // Samples ever recorded
+};
+
+// Times its own lifetime into a zone
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfileZone zone) : zone(zone), parent(Profiler::activeZone), start(Profiler::now()) {
+        Profiler::activeZone = (int)zone;
+    }
+    ~ProfileScope() {
+        Profiler::record(zone, start, Profiler::now());
+        Profiler::activeZone = parent;
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileZone zone;
+    int parent;  // Zone to restore on exit
+    uint64_t start;
+};
+
+} // namespace BlockEater
+
+// PROFILE_ZONE(ProfileZone::X) times the rest of the enclosing block. Without
+// BLOCK_PROFILE it expands to nothing, so release builds pay nothing
+#ifdef BLOCK_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(zone) ::BlockEater::ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(zone)
+#else
+#define PROFILE_ZONE(zone) ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,280 @@
+#include "player.h"
+#include "enemy.h"
+#include "bullet.h"
+#include "particles.h"
+#include "skills.h"
+#include "game.h"
+#include "rlgl.h"
+#include <cstdio>
+#include <cmath>
+
+// Drawing for the simulation's types. It lives apart from their logic so
+// the sim library (block_sim_core) builds without raylib's graphics.
+
+namespace BlockEater {
+
+void Player::draw(float alpha) {
+    // Blink when invincible
+    if (invincibleTime > 0 && fmodf(invincibleTime, 0.1f) < 0.05f) {
+        return;
+    }
+
+    Color c = getColor();
+    Vector2 drawPos = getRenderPosition(alpha);
+
+    // Draw shadow
+    DrawRectangle(
+        (int)drawPos.x - size/2 + 4,
+        (int)drawPos.y - size/2 + 4,
+        size, size,
+        {0, 0, 0, 100}
+    );
+
+    // Draw main block
+    DrawRectangle(
+        (int)drawPos.x - size/2,
+        (int)drawPos.y - size/2,
+        size, size,
+        c
+    );
+
+    // Draw pixel border
+    DrawRectangleLines(
+        (int)drawPos.x - size/2,
+        (int)drawPos.y - size/2,
+        size, size,
+        {255, 255, 255, 180}
+    );
+
+    // Draw highlight
+    int highlightSize = size / 3;
+    DrawRectangle(
+        (int)drawPos.x - size/2 + 2,
+        (int)drawPos.y - size/2 + 2,
+        highlightSize, highlightSize,
+        {255, 255, 255, 100}
+    );
+
+    // Draw level indicator
+    char levelText[16];
+    sprintf(levelText, "L%d", level);
+    int fontSize = 10;
+    int textWidth = MeasureText(levelText, fontSize);
+    DrawText(levelText,
+             (int)drawPos.x - textWidth/2,
+             (int)drawPos.y - fontSize/2,
+             fontSize, WHITE);
+             
+    // Draw bullet skill indicator
+    if (bulletSkillEnabled) {
+        DrawCircleLines((int)drawPos.x, (int)drawPos.y, size/2 + 5, {255, 255, 0, 150});
+    }
+    
+    // Draw velocity indicator (small arrow)
+    if (Vector2Length(velocity) > 10.0f) {
+        Vector2 dir = Vector2Normalize(velocity);
+        int arrowLen = size / 2 + 10;
+        Vector2 end = {drawPos.x + dir.x * arrowLen, drawPos.y + dir.y * arrowLen};
+        DrawLine((int)drawPos.x, (int)drawPos.y, (int)end.x, (int)end.y, 
+                 {255, 255, 255, 150});
+    }
+}
+
+// One axis-aligned quad into the open RL_QUADS batch
+static void batchQuad(int x, int y, int width, int height, Color color) {
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlTexCoord2f(0.0f, 0.0f);
+    rlVertex2f((float)x, (float)y);
+    rlTexCoord2f(0.0f, 1.0f);
+    rlVertex2f((float)x, (float)(y + height));
+    rlTexCoord2f(1.0f, 1.0f);
+    rlVertex2f((float)(x + width), (float)(y + height));
+    rlTexCoord2f(1.0f, 0.0f);
+    rlVertex2f((float)(x + width), (float)y);
+}
+
+void EnemySprite::draw(float alpha) const {
+    drawBatch(this, 1, alpha);
+}
+
+void EnemySprite::drawBatch(const EnemySprite* sprites, int count, float alpha) {
+    // The default texture is the 1x1 white one plain shapes use, so these
+    // quads merge with any rectangles drawn around them
+    rlSetTexture(rlGetTextureIdDefault());
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    for (int i = 0; i < count; i++) {
+        const EnemySprite& sprite = sprites[i];
+        int size = sprite.size;
+
+        // Flushes the batch if this sprite wouldn't fit
+        rlCheckRenderBatchLimit(4 * MAX_QUADS);
+
+        // Interpolate between the last two ticks
+        Vector2 drawPos = sprite.from + (sprite.to - sprite.from) * alpha;
+        int left = (int)drawPos.x - size/2;
+        int top = (int)drawPos.y - size/2;
+
+        // Shadow
+        batchQuad(left + 3, top + 3, size, size, {0, 0, 0, 80});
+
+        // Enemy block
+        batchQuad(left, top, size, size, sprite.color);
+
+        // Pixel border, as four 1 px quads (lines would end the batch)
+        Color border = {255, 255, 255, 150};
+        batchQuad(left, top, size, 1, border);
+        batchQuad(left, top + size - 1, size, 1, border);
+        batchQuad(left, top + 1, 1, size - 2, border);
+        batchQuad(left + size - 1, top + 1, 1, size - 2, border);
+
+        // Eyes for chasing enemies
+        if (sprite.eyes) {
+            int eyeSize = size / 5;
+            batchQuad((int)drawPos.x - size/4 - eyeSize/2, (int)drawPos.y - size/4 - eyeSize/2,
+                      eyeSize, eyeSize, sprite.eyeColor);
+            batchQuad((int)drawPos.x + size/4 - eyeSize/2, (int)drawPos.y - size/4 - eyeSize/2,
+                      eyeSize, eyeSize, sprite.eyeColor);
+        }
+
+        // Health bar above enemy
+        if (sprite.healthPercent < 1.0f) {
+            int barWidth = size;
+            int barHeight = 4;
+            int barLeft = (int)drawPos.x - barWidth/2;
+            int barTop = (int)drawPos.y - size/2 - 10;
+            batchQuad(barLeft, barTop, barWidth, barHeight, {50, 50, 50, 200});
+            batchQuad(barLeft, barTop, (int)(barWidth * sprite.healthPercent), barHeight, sprite.hpColor);
+        }
+    }
+
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void BulletSprite::draw(float alpha) const {
+    Vector2 pos = from + (to - from) * alpha;
+    const int size = BulletPool::SIZE;
+
+    // Draw bullet with glow effect
+    DrawCircle((int)pos.x, (int)pos.y, size, {255, 255, 100, 150});  // Outer glow
+    DrawCircle((int)pos.x, (int)pos.y, size - 2, {255, 255, 0, 255});  // Core
+
+    // Draw trail
+    for (int t = 1; t <= 3; t++) {
+        float trailAlpha = 100 - t * 30;
+        float trailSize = size - t * 2;
+        Vector2 trailPos = {
+            pos.x - velocity.x * 0.01f * t,
+            pos.y - velocity.y * 0.01f * t
+        };
+        DrawCircle((int)trailPos.x, (int)trailPos.y, (int)trailSize, {255, 255, 0, (unsigned char)trailAlpha});
+    }
+}
+
+// Fades out over the particle's lifetime
+static Color fadedColor(const ParticleColumns& cols, int i) {
+    Color c = cols.color[i];
+    c.a = (unsigned char)(cols.lifeTime[i] / cols.maxLifeTime[i] * 255);
+    return c;
+}
+
+int ParticleSystem::draw(Rectangle view, int& culled) {
+    int drawn = 0;
+
+    // Pixels
+    for (int i = 0; i < pixels.count(); i++) {
+        Vector2 pos = pixels.position[i];
+        if (!CheckCollisionPointRec(pos, view)) {
+            culled++;
+            continue;
+        }
+        int size = (int)pixelSize[i];
+        DrawRectangle((int)pos.x, (int)pos.y, size, size, fadedColor(pixels, i));
+        drawn++;
+    }
+
+    // Text popups
+    for (int i = 0; i < texts.count(); i++) {
+        Vector2 pos = texts.position[i];
+        if (!CheckCollisionPointRec(pos, view)) {
+            culled++;
+            continue;
+        }
+        DrawText(textValue[i].value, (int)pos.x, (int)pos.y, 20, fadedColor(texts, i));
+        drawn++;
+    }
+
+    // Level up effects (at the player, never culled)
+    for (int i = 0; i < levelUps.count(); i++) {
+        Color c = fadedColor(levelUps, i);
+        Vector2 pos = levelUps.position[i];
+        float age = levelUps.maxLifeTime[i] - levelUps.lifeTime[i];
+        float scale = 1.0f + age * 2.0f;
+        float rotation = age * 180.0f;
+
+        char text[32];
+        sprintf(text, "LEVEL %d!", levelUpLevel[i]);
+
+        int fontSize = (int)(30 * scale);
+        int textWidth = MeasureText(text, fontSize);
+
+        // Draw with rotation effect (simulated by oscillating position)
+        float wave = sinf(rotation * DEG2RAD) * 5.0f;
+        DrawText(text, (int)(pos.x - textWidth/2 + wave), (int)pos.y, fontSize, c);
+
+        // Draw star burst
+        for (int j = 0; j < 8; j++) {
+            float angle = (j * 45 + rotation) * DEG2RAD;
+            float dist = 30 * scale;
+            Vector2 starPos = {
+                pos.x + cosf(angle) * dist,
+                pos.y + sinf(angle) * dist
+            };
+            DrawCircleV(starPos, 3 * scale, c);
+        }
+        drawn++;
+    }
+    return drawn;
+}
+
+void SkillManager::draw() {
+    // Draw skill buttons in bottom-right corner
+    float buttonSize = 60.0f;
+    float startX = SCREEN_WIDTH - 280.0f;
+    float startY = SCREEN_HEIGHT - 80.0f;
+    float spacing = 70.0f;
+
+    for (int i = 0; i < 4; i++) {
+        float x = startX + i * spacing;
+        float y = startY;
+
+        // Draw button background
+        Color bgColor = skills[i].buttonColor;
+        if (!skills[i].isReady()) {
+            // Dim the button when on cooldown
+            bgColor = {(unsigned char)(bgColor.r / 3), (unsigned char)(bgColor.g / 3), (unsigned char)(bgColor.b / 3), 200};
+        }
+        DrawRectangle((int)x, (int)y, (int)buttonSize, (int)buttonSize, bgColor);
+        DrawRectangleLines((int)x, (int)y, (int)buttonSize, (int)buttonSize, WHITE);
+
+        // Draw skill icon (simple circle)
+        DrawCircle((int)(x + buttonSize/2), (int)(y + buttonSize/2), 15, {255, 255, 255, 200});
+
+        // Draw cooldown overlay
+        if (!skills[i].isReady()) {
+            float cooldownPercent = skills[i].currentCooldown / skills[i].cooldown;
+            int cooldownHeight = (int)(buttonSize * cooldownPercent);
+            DrawRectangle((int)x, (int)y, (int)buttonSize, cooldownHeight, {0, 0, 0, 150});
+        }
+
+        // Draw skill number
+        char numText[8];
+        sprintf(numText, "%d", i + 1);
+        int textWidth = MeasureText(numText, 20);
+        DrawText(numText, (int)(x + buttonSize - textWidth - 5), (int)(y + buttonSize - 25), 20, WHITE);
+    }
+}
+
+} // namespace BlockEater
@@ -0,0 +1,173 @@
+#include "replay.h"
+#include "game.h"
+#include <cstdio>
+
+namespace BlockEater {
+
+namespace {
+
+const int REPLAY_MAGIC = 0x42455250;  // "BERP" - Block Eater RePlay
+const int REPLAY_VERSION = 1;
+
+// Counts past these are a corrupt header, not a long run (a day at 240 Hz)
+const uint32_t MAX_REPLAY_TICKS = 24u * 60 * 60 * 240;
+const uint32_t MAX_REPLAY_SKILLS = MAX_REPLAY_TICKS;  // At most one press per tick in practice
+const int MAX_REPLAY_TICK_RATE = 240;
+
+// Bytes from the read position to the end of the file, -1 if unknown
+long remainingBytes(FILE* file) {
+    long here = ftell(file);
+    if (here < 0 || fseek(file, 0, SEEK_END) != 0) return -1;
+    long end = ftell(file);
+    if (fseek(file, here, SEEK_SET) != 0) return -1;
+    return end - here;
+}
+
+} // namespace
+
+Replay::Replay()
+    : seed(0)
+    , mode(0)
+    , level(0)
+    , tickRate(0)
+    , nextSkill(0)
+{
+}
+
+void Replay::begin(uint64_t newSeed, int newMode, int newLevel, int newTickRate) {
+    seed = newSeed;
+    mode = newMode;
+    level = newLevel;
+    tickRate = newTickRate;
+    ticks.clear();
+    skills.clear();
+    // Kept across runs: only the first recording (or a faster tick rate) allocates
+    ticks.reserve((size_t)newTickRate * 60 * RESERVED_MINUTES);
+    skills.reserve(RESERVED_SKILLS);
+    nextSkill = 0;
+}
+
+void Replay::recordSkill(int skill) {
+    skills.push_back({(uint32_t)ticks.size(), (int32_t)skill});
+}
+
+void Replay::recordTick(Vector2 move, uint32_t hash) {
+    ticks.push_back({toFixed(move.x), toFixed(move.y), hash});
+}
+
+bool Replay::save(const char* path) const {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        TraceLog(LOG_ERROR, "Failed to open replay file for writing");
+        return false;
+    }
+
+    uint32_t tickCount = (uint32_t)ticks.size();
+    uint32_t skillCount = (uint32_t)skills.size();
+    bool ok = fwrite(&REPLAY_MAGIC, sizeof(int), 1, file) == 1 &&
+              fwrite(&REPLAY_VERSION, sizeof(int), 1, file) == 1 &&
+              fwrite(&seed, sizeof(seed), 1, file) == 1 &&
+              fwrite(&mode, sizeof(int), 1, file) == 1 &&
+              fwrite(&level, sizeof(int), 1, file) == 1 &&
+              fwrite(&tickRate, sizeof(int), 1, file) == 1 &&
+              fwrite(&tickCount, sizeof(tickCount), 1, file) == 1 &&
+              fwrite(&skillCount, sizeof(skillCount), 1, file) == 1 &&
+              fwrite(ticks.data(), sizeof(Tick), tickCount, file) == tickCount &&
+              fwrite(skills.data(), sizeof(Skill), skillCount, file) == skillCount;
+    // fclose flushes, so a full disk may only show up here
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        TraceLog(LOG_ERROR, TextFormat("REPLAY: failed to write %s", path));
+        return false;
+    }
+    TraceLog(LOG_INFO, TextFormat("REPLAY: saved %u ticks to %s", tickCount, path));
+    return true;
+}
+
+bool Replay::load(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        TraceLog(LOG_ERROR, TextFormat("REPLAY: cannot open %s", path));
+        return false;
+    }
+
+    // Everything goes into locals first; the replay only changes once the
+    // whole file has been read and checked
+    int magic = 0;
+    int version = 0;
+    uint64_t newSeed = 0;
+    int newMode = 0;
+    int newLevel = 0;
+    int newTickRate = 0;
+    uint32_t tickCount = 0;
+    uint32_t skillCount = 0;
+    bool ok = fread(&magic, sizeof(int), 1, file) == 1 && magic == REPLAY_MAGIC &&
+              fread(&version, sizeof(int), 1, file) == 1 && version == REPLAY_VERSION &&
+              fread(&newSeed, sizeof(newSeed), 1, file) == 1 &&
+              fread(&newMode, sizeof(int), 1, file) == 1 &&
+              fread(&newLevel, sizeof(int), 1, file) == 1 &&
+              fread(&newTickRate, sizeof(int), 1, file) == 1 &&
+              fread(&tickCount, sizeof(tickCount), 1, file) == 1 &&
+              fread(&skillCount, sizeof(skillCount), 1, file) == 1;
+    if (ok && (newTickRate < 1 || newTickRate > MAX_REPLAY_TICK_RATE ||
+               newMode < (int)GameMode::ENDLESS || newMode > (int)GameMode::TIME_CHALLENGE)) {
+        TraceLog(LOG_ERROR, TextFormat("REPLAY: %s has tick rate %d and mode %d", path, newTickRate, newMode));
+        ok = false;
+    }
+    if (ok) {
+        // Check the counts before sizing anything by them
+        long remaining = remainingBytes(file);
+        unsigned long long needed = (unsigned long long)tickCount * sizeof(Tick) +
+                                    (unsigned long long)skillCount * sizeof(Skill);
+        if (tickCount > MAX_REPLAY_TICKS || skillCount > MAX_REPLAY_SKILLS ||
+            remaining < 0 || needed > (unsigned long long)remaining) {
+            TraceLog(LOG_ERROR, TextFormat("REPLAY: %s claims %u ticks and %u skills in %ld bytes",
+                                           path, tickCount, skillCount, remaining));
+            ok = false;
+        }
+    }
+    std::vector<Tick> newTicks;
+    std::vector<Skill> newSkills;
+    if (ok) {
+        newTicks.resize(tickCount);
+        newSkills.resize(skillCount);
+        ok = fread(newTicks.data(), sizeof(Tick), tickCount, file) == tickCount &&
+             fread(newSkills.data(), sizeof(Skill), skillCount, file) == skillCount;
+    }
+    fclose(file);
+
+    if (!ok) {
+        TraceLog(LOG_ERROR, "REPLAY: invalid replay file");
+        return false;
+    }
+    seed = newSeed;
+    mode = newMode;
+    level = newLevel;
+    tickRate = newTickRate;
+    ticks.swap(newTicks);
+    skills.swap(newSkills);
+    nextSkill = 0;
+    return true;
+}
+
+Vector2 Replay::getMove(unsigned int tick) const {
+    return {ticks[tick].moveX / MOVE_SCALE, ticks[tick].moveY / MOVE_SCALE};
+}
+
+int Replay::popSkill(unsigned int tick) {
+    if (nextSkill >= skills.size() || skills[nextSkill].tick > tick) return -1;
+    return skills[nextSkill++].skill;
+}
+
+Vector2 Replay::quantize(Vector2 move) {
+    return {toFixed(move.x) / MOVE_SCALE, toFixed(move.y) / MOVE_SCALE};
+}
+
+int16_t Replay::toFixed(float value) {
+    if (value > 1.0f) value = 1.0f;
+    if (value < -1.0f) value = -1.0f;
+    float scaled = value * MOVE_SCALE;
+    return (int16_t)(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+}
+
+} // namespace BlockEater
@@ -0,0 +1,101 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "raylib.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace BlockEater {
+
+// FNV-1a over simulation state, for spotting where a replay diverges
+class StateHash {
+public:
+    StateHash() : hash(2166136261u) {}
+
+    void add(const void* data, size_t size) {
+        const unsigned char* bytes = (const unsigned char*)data;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+    }
+    void add(int value) { add(&value, sizeof(value)); }
+    void add(unsigned int value) { add(&value, sizeof(value)); }
+    void add(float value) { add(&value, sizeof(value)); }
+    void add(Vector2 value) { add(value.x); add(value.y); }
+
+    uint32_t get() const { return hash; }
+
+private:
+    uint32_t hash;
+};
+
+// One run's input, tick by tick. The sim is deterministic given the seed,
+// mode, level, tick rate and the per-tick input, so that is all a replay
+// stores; the state hash after each tick tells where playback drifts.
+//
+// File layout (little-endian, as written by fwrite on every target):
+//   header, tickCount x {int16 moveX, int16 moveY, uint32 hash},
+//   skillCount x {uint32 tick, int32 skill}
+class Replay {
+public:
+    static constexpr char REPLAY_FILE_PATH[] = "last_run.replay";
+
+    Replay();
+
+    // Recording. begin() reserves RESERVED_MINUTES of ticks and
+    // RESERVED_SKILLS presses, so recording allocates nothing in a run
+    // shorter than that; past it the columns grow by doubling
+    static constexpr int RESERVED_MINUTES = 30;
+    static constexpr int RESERVED_SKILLS = 4096;
+
+    void begin(uint64_t seed, int mode, int level, int tickRate);
+    void recordSkill(int skill);  // Pressed before the tick recordTick() closes
+    void recordTick(Vector2 move, uint32_t hash);
+    bool save(const char* path) const;
+
+    // Playback. A file that fails to load (logged) leaves the replay as it was
+    bool load(const char* path);
+    void rewind() { nextSkill = 0; }
+    bool hasTick(unsigned int tick) const { return tick < ticks.size(); }
+    Vector2 getMove(unsigned int tick) const;
+    uint32_t getHash(unsigned int tick) const { return ticks[tick].hash; }
+    int popSkill(unsigned int tick);  // Next skill pressed before tick, -1 when none
+
+    uint64_t getSeed() const { return seed; }
+    int getMode() const { return mode; }
+    int getLevel() const { return level; }
+    int getTickRate() const { return tickRate; }
+    unsigned int getTickCount() const { return (unsigned int)ticks.size(); }
+
+    // Joystick input is stored as 16-bit fixed point; live runs use the
+    // quantized value too, so playback feeds the sim the exact same input
+    static Vector2 quantize(Vector2 move);
+
+private:
+    struct Tick {
+        int16_t moveX;
+        int16_t moveY;
+        uint32_t hash;
+    };
+
+    struct Skill {
+        uint32_t tick;
+        int32_t skill;
+    };
+
+    uint64_t seed;
+    int mode;
+    int level;
+    int tickRate;
+    std::vector<Tick> ticks;
+    std::vector<Skill> skills;  // In tick order
+    size_t nextSkill;           // Playback cursor into skills
+
+    static constexpr float MOVE_SCALE = 32767.0f;
+    static int16_t toFixed(float value);
+};
+
+} // namespace BlockEater
+
+#endif // REPLAY_H
@@ -0,0 +1,150 @@
+#include "scenario.h"
+#include "raylib.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace BlockEater {
+
+namespace {
+
+// Population keys in EnemyType order
+const char* const TYPE_KEYS[Scenario::TYPE_COUNT] = {"floating", "chasing", "stationary", "bouncing"};
+
+const float STRESS_DURATION = 60.0f;
+const float STRESS_BULLETS_PER_ENEMY = 0.01f;  // Shots per second per enemy alive
+
+// Strips leading and trailing blanks in place
+char* trim(char* text) {
+    while (*text == ' ' || *text == '\t') text++;
+    char* end = text + strlen(text);
+    while (end > text && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '\n')) {
+        end--;
+    }
+    *end = '\0';
+    return text;
+}
+
+} // namespace
+
+Scenario::Scenario()
+    : name{0}
+    , seed(1)
+    , duration(STRESS_DURATION)
+    , population{0, 0, 0, 0}
+    , sizeMin(10)
+    , sizeMax(60)
+    , sizeBias(1.0f)
+    , bulletRate(0)
+    , bulletDamage(5)
+    , invulnerable(true)
+{
+    strcpy(name, "scenario");
+}
+
+int Scenario::getTotalPopulation() const {
+    int total = 0;
+    for (int t = 0; t < TYPE_COUNT; t++) {
+        total += population[t];
+    }
+    return total;
+}
+
+bool Scenario::load(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        TraceLog(LOG_ERROR, TextFormat("SCENARIO: cannot open %s", path));
+        return false;
+    }
+
+    Scenario loaded;
+    char line[256];
+    int lineNumber = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        char* text = trim(line);
+        if (*text == '\0') continue;
+
+        char* equals = strchr(text, '=');
+        if (!equals) {
+            ok = false;
+            break;
+        }
+        *equals = '\0';
+        const char* key = trim(text);
+        const char* value = trim(equals + 1);
+
+        bool known = true;
+        if (strcmp(key, "name") == 0) {
+            strncpy(loaded.name, value, sizeof(loaded.name) - 1);
+        } else if (strcmp(key, "seed") == 0) {
+            loaded.seed = strtoull(value, nullptr, 10);
+        } else if (strcmp(key, "duration") == 0) {
+            loaded.duration = (float)atof(value);
+        } else if (strcmp(key, "size_min") == 0) {
+            loaded.sizeMin = atoi(value);
+        } else if (strcmp(key, "size_max") == 0) {
+            loaded.sizeMax = atoi(value);
+        } else if (strcmp(key, "size_bias") == 0) {
+            loaded.sizeBias = (float)atof(value);
+        } else if (strcmp(key, "bullet_rate") == 0) {
+            loaded.bulletRate = (float)atof(value);
+        } else if (strcmp(key, "bullet_damage") == 0) {
+            loaded.bulletDamage = atoi(value);
+        } else if (strcmp(key, "invulnerable") == 0) {
+            loaded.invulnerable = atoi(value) != 0;
+        } else {
+            known = false;
+            for (int t = 0; t < TYPE_COUNT; t++) {
+                if (strcmp(key, TYPE_KEYS[t]) == 0) {
+                    loaded.population[t] = atoi(value);
+                    known = true;
+                }
+            }
+        }
+        ok = known;
+    }
+    fclose(file);
+
+    if (ok) {
+        // Negative counts or an empty size range would break spawning
+        int total = 0;
+        for (int t = 0; t < TYPE_COUNT; t++) {
+            if (loaded.population[t] < 0) ok = false;
+            total += loaded.population[t];
+        }
+        ok = ok && total <= MAX_POPULATION && loaded.duration >= 0 &&
+             loaded.sizeMin > 0 && loaded.sizeMax >= loaded.sizeMin && loaded.sizeBias > 0 &&
+             loaded.bulletRate >= 0;
+        if (!ok) {
+            TraceLog(LOG_ERROR, TextFormat("SCENARIO: values out of range in %s", path));
+            return false;
+        }
+    } else {
+        TraceLog(LOG_ERROR, TextFormat("SCENARIO: bad line %d in %s", lineNumber, path));
+        return false;
+    }
+
+    *this = loaded;
+    TraceLog(LOG_INFO, TextFormat("SCENARIO: loaded %s, %d enemies", name, getTotalPopulation()));
+    return true;
+}
+
+Scenario Scenario::stress(int total) {
+    Scenario scenario;
+    if (total < 0) total = 0;
+    if (total > MAX_POPULATION) total = MAX_POPULATION;
+    snprintf(scenario.name, sizeof(scenario.name), "stress_%d", total);
+    for (int t = 0; t < TYPE_COUNT; t++) {
+        // Remainder to the first types, so the counts add up to total
+        scenario.population[t] = total / TYPE_COUNT + (t < total % TYPE_COUNT ? 1 : 0);
+    }
+    scenario.sizeBias = 1.5f;  // Mostly food with some big threats, like a normal run
+    scenario.bulletRate = total * STRESS_BULLETS_PER_ENEMY;
+    return scenario;
+}
+
+} // namespace BlockEater
@@ -0,0 +1,56 @@
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <cstdint>
+
+namespace BlockEater {
+
+// A stress run: instead of the time-based spawn curve, the sim holds each
+// enemy type at a fixed population anywhere in the world, and enemy fire
+// comes in at a fixed rate. Used to find how far the sim and renderer
+// scale, from the settings screen (BLOCK_PROFILE builds) or block_sim.
+//
+// File format, one "key = value" per line, '#' starts a comment:
+//   name = stress_10k
+//   seed = 7
+//   duration = 120          # Seconds of sim time, 0 runs until stopped
+//   floating = 2500         # Population per EnemyType
+//   chasing = 2500
+//   stationary = 2500
+//   bouncing = 2500
+//   size_min = 10           # Sizes are min + (max - min) * u^bias,
+//   size_max = 60           # u uniform in [0, 1): bias > 1 favours small
+//   size_bias = 1.5
+//   bullet_rate = 100       # Enemy shots per second aimed at the player
+//   bullet_damage = 5
+//   invulnerable = 1        # The player is healed instead of dying
+struct Scenario {
+    static constexpr int TYPE_COUNT = 4;  // One population per EnemyType
+    static constexpr int MAX_POPULATION = 100000;  // Per scenario, all types together
+
+    char name[32];
+    uint64_t seed;
+    float duration;
+    int population[TYPE_COUNT];
+    int sizeMin;
+    int sizeMax;
+    float sizeBias;
+    float bulletRate;
+    int bulletDamage;
+    bool invulnerable;
+
+    Scenario();
+
+    int getTotalPopulation() const;
+
+    // Unknown keys or out-of-range values fail the load (logged)
+    bool load(const char* path);
+
+    // Built-in preset: total enemies split evenly over the types, with
+    // enemy fire scaled to the population
+    static Scenario stress(int total);
+};
+
+} // namespace BlockEater
+
+#endif // SCENARIO_H
@@ -0,0 +1,316 @@
+#include "simulation.h"
+#include "audio.h"
+#include "bullet.h"
+#include "enemy.h"
+#include "entities.h"
+#include "jobs.h"
+#include "particles.h"
+#include "player.h"
+#include "spatial.h"
+#include "raylib.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+using namespace BlockEater;
+
+// block_bench: times the hot paths of a tick one at a time at several
+// entity counts, on seeded scenarios so two builds see the same work.
+// Prints the median time per entity and heap allocations per iteration;
+// --csv output is meant to be kept and diffed against later runs.
+
+// Every operator new in the process counts, worker threads included
+static std::atomic<long long> allocationCount(0);
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace {
+
+const int ENTITY_COUNTS[] = {100, 400, 2000, 10000};
+const float TICK_DT = 1.0f / DEFAULT_TICK_RATE;
+const float ENEMY_SPACING = 40.0f;   // Average distance between scenario enemies
+const int BULLETS_PER_ENEMY = 10;    // One bullet per this many enemies
+const int MIN_ITERATIONS = 5;
+const int MAX_ITERATIONS = 2000;
+const int WAVE_SAMPLE_RATE = 44100;
+
+struct Options {
+    uint64_t seed = 1;
+    int workers = 0;         // Inline by default: per-entity cost, not speedup
+    double minTime = 0.25;   // Timed seconds per benchmark and size
+    const char* filter = nullptr;
+    bool csv = false;
+};
+
+// State shared by the benchmarks of one entity count
+struct Fixture {
+    Simulation* sim;
+    int count;
+    uint64_t seed;
+    EnemyCommandBuffer commands;
+    ParticleSystem particles;
+    std::vector<short> samples;
+};
+
+struct Benchmark {
+    const char* name;
+    const char* unit;                  // What one entity is
+    void (*setup)(Fixture& fixture);   // Once per entity count
+    void (*prepare)(Fixture& fixture); // Before every timed run, untimed
+    int (*run)(Fixture& fixture);      // Timed; returns entities processed
+};
+
+struct Result {
+    int iterations = 0;
+    double medianSeconds = 0;
+    int entities = 0;
+    double allocations = 0;  // Per iteration
+};
+
+double clockSeconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+// count enemies spread evenly around the player at the world centre, with
+// types and sizes from the seed, plus a player and enemy bullet stream
+void buildWorld(Fixture& fixture) {
+    Simulation& sim = *fixture.sim;
+    sim.start(GameMode::ENDLESS, 1, fixture.seed);
+    Vector2 centre = {WORLD_WIDTH / 2.0f, WORLD_HEIGHT / 2.0f};
+    sim.player->setPosition(centre);
+    sim.player->resetInterpolation();
+
+    float half = sqrtf((float)fixture.count) * ENEMY_SPACING / 2.0f;
+    float halfWidth = std::min(half, WORLD_WIDTH / 2.0f - 100.0f);
+    float halfHeight = std::min(half, WORLD_HEIGHT / 2.0f - 100.0f);
+
+    Random random(fixture.seed, RandomStream::BENCH);
+    for (int i = 0; i < fixture.count; i++) {
+        EnemyType type = (EnemyType)random.nextInt(EnemyStore::ARCHETYPE_COUNT);
+        Vector2 pos = {centre.x + random.nextFloat(-halfWidth, halfWidth),
+                       centre.y + random.nextFloat(-halfHeight, halfHeight)};
+        int size = 10 + random.nextInt(50);
+        Enemy* enemy = sim.enemies->spawn(type, pos, size);
+        sim.enemyGrid->insert(enemy);
+    }
+
+    int bulletCount = std::min(fixture.count / BULLETS_PER_ENEMY, BulletPool::CAPACITY);
+    for (int i = 0; i < bulletCount; i++) {
+        Vector2 pos = {centre.x + random.nextFloat(-halfWidth, halfWidth),
+                       centre.y + random.nextFloat(-halfHeight, halfHeight)};
+        float angle = random.nextFloat(0.0f, 2.0f * PI);
+        sim.bullets->spawn(pos, {cosf(angle), sinf(angle)}, 20, (i % 2 == 0) ? 0 : -1);
+    }
+}
+
+// checkCollisions on a fresh world each run: the physics and bullet passes
+// before it fill the contacts and hits it consumes
+void prepareCollisions(Fixture& fixture) {
+    buildWorld(fixture);
+    fixture.sim->updatePhysics(TICK_DT);
+    fixture.sim->updateBullets(TICK_DT);
+}
+
+int runCollisions(Fixture& fixture) {
+    fixture.sim->checkCollisions();
+    return fixture.count;
+}
+
+// Enemy::update on every enemy, the world left as it is between runs
+void setupEnemyUpdate(Fixture& fixture) {
+    buildWorld(fixture);
+    fixture.sim->bulletGrid->build(*fixture.sim->bullets);
+}
+
+void prepareEnemyUpdate(Fixture& fixture) {
+    fixture.commands.clear();
+}
+
+int runEnemyUpdate(Fixture& fixture) {
+    Simulation& sim = *fixture.sim;
+    Vector2 playerPos = sim.player->getPosition();
+    EnemyCommandBuffer& commands = fixture.commands;
+    sim.enemies->forEach([&](Enemy* enemy) {
+        enemy->update(TICK_DT, playerPos, *sim.bullets, *sim.enemyGrid, *sim.bulletGrid, commands);
+    });
+    return fixture.count;
+}
+
+// One spawn group of count enemies into an empty world
+void prepareSpawn(Fixture& fixture) {
+    fixture.sim->start(GameMode::ENDLESS, 1, fixture.seed);
+    fixture.sim->player->setPosition({WORLD_WIDTH / 2.0f, WORLD_HEIGHT / 2.0f});
+}
+
+int runSpawn(Fixture& fixture) {
+    fixture.sim->spawnEnemyGroup(fixture.count);
+    return fixture.count;
+}
+
+// ParticleSystem::update over count particles, one in ten a text popup.
+// Refilled once particles start expiring, so runs include some cleanup
+void prepareParticles(Fixture& fixture) {
+    if (fixture.particles.getParticleCount() >= fixture.count) return;
+
+    fixture.particles = ParticleSystem();
+    fixture.particles.setSeed(fixture.seed);
+    Vector2 centre = {WORLD_WIDTH / 2.0f, WORLD_HEIGHT / 2.0f};
+    int texts = fixture.count / 10;
+    for (int i = 0; i < texts; i++) {
+        fixture.particles.spawnDamageNumber(centre, i, (i % 2) == 0);
+    }
+    fixture.particles.spawnPixelExplosion(centre, {255, 255, 0, 255}, fixture.count - texts);
+}
+
+int runParticles(Fixture& fixture) {
+    int particles = fixture.particles.getParticleCount();  // Spawns past the table caps are dropped
+    fixture.particles.update(TICK_DT);
+    return particles;
+}
+
+// GenerateWave: count samples of each wave type
+void setupWave(Fixture& fixture) {
+    fixture.samples.assign(fixture.count, 0);
+}
+
+int runWave(Fixture& fixture) {
+    float duration = (float)(fixture.count + 1) / WAVE_SAMPLE_RATE;
+    const WaveType types[] = {WAVE_SINE, WAVE_SQUARE, WAVE_SAWTOOTH, WAVE_TRIANGLE};
+    for (WaveType type : types) {
+        AudioGenerator::GenerateWave(fixture.samples.data(), fixture.count, 440, duration, type, 0.5f);
+    }
+    return fixture.count * 4;
+}
+
+void noSetup(Fixture&) {}
+void noPrepare(Fixture&) {}
+
+const Benchmark BENCHMARKS[] = {
+    {"checkCollisions", "enemy", noSetup, prepareCollisions, runCollisions},
+    {"Enemy::update", "enemy", setupEnemyUpdate, prepareEnemyUpdate, runEnemyUpdate},
+    {"spawnEnemies", "enemy", noSetup, prepareSpawn, runSpawn},
+    {"ParticleSystem::update", "particle", noSetup, prepareParticles, runParticles},
+    {"GenerateWave", "sample", setupWave, noPrepare, runWave},
+};
+
+Result measure(const Benchmark& bench, Fixture& fixture, double minTime) {
+    bench.setup(fixture);
+
+    // Warm up caches and buffers that grow on first use
+    bench.prepare(fixture);
+    bench.run(fixture);
+
+    std::vector<double> times;
+    times.reserve(MAX_ITERATIONS);
+    long long allocations = 0;
+    double total = 0;
+    Result result;
+    while (result.iterations < MIN_ITERATIONS || (total < minTime && result.iterations < MAX_ITERATIONS)) {
+        bench.prepare(fixture);
+        long long allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        double start = clockSeconds();
+        result.entities = bench.run(fixture);
+        double elapsed = clockSeconds() - start;
+        allocations += allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+        times.push_back(elapsed);
+        total += elapsed;
+        result.iterations++;
+    }
+
+    std::sort(times.begin(), times.end());
+    result.medianSeconds = times[times.size() / 2];
+    result.allocations = (double)allocations / result.iterations;
+    return result;
+}
+
+void printUsage() {
+    printf("usage: block_bench [--filter NAME] [--seed S] [--workers W] [--min-time SECONDS] [--csv]\n");
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--csv") == 0) {
+            options.csv = true;
+            continue;
+        }
+        if (!value) return false;
+        i++;
+        if (strcmp(arg, "--filter") == 0) {
+            options.filter = value;
+        } else if (strcmp(arg, "--seed") == 0) {
+            options.seed = strtoull(value, nullptr, 10);
+        } else if (strcmp(arg, "--workers") == 0) {
+            options.workers = atoi(value);
+        } else if (strcmp(arg, "--min-time") == 0) {
+            options.minTime = atof(value);
+        } else {
+            return false;
+        }
+    }
+    return options.minTime >= 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    Simulation sim(options.workers);
+    if (options.csv) {
+        printf("benchmark,entities,iterations,ns_per_iteration,ns_per_entity,allocations_per_iteration\n");
+    } else {
+        printf("%-24s %8s %-9s %6s %14s %12s %12s\n", "benchmark", "entities", "", "iters",
+               "ns/iter", "ns/entity", "allocs/iter");
+    }
+
+    for (const Benchmark& bench : BENCHMARKS) {
+        if (options.filter && !strstr(bench.name, options.filter)) continue;
+
+        for (int count : ENTITY_COUNTS) {
+            Fixture fixture;
+            fixture.sim = &sim;
+            fixture.count = count;
+            fixture.seed = options.seed;
+
+            Result result = measure(bench, fixture, options.minTime);
+            double nsPerIteration = result.medianSeconds * 1e9;
+            double nsPerEntity = nsPerIteration / (result.entities > 0 ? result.entities : 1);
+            if (options.csv) {
+                printf("%s,%d,%d,%.0f,%.2f,%.1f\n", bench.name, count, result.iterations,
+                       nsPerIteration, nsPerEntity, result.allocations);
+            } else {
+                printf("%-24s %8d %-9s %6d %14.0f %12.2f %12.1f\n", bench.name, count, bench.unit,
+                       result.iterations, nsPerIteration, nsPerEntity, result.allocations);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,301 @@
+#include "simulation.h"
+#include "entities.h"
+#include "jobs.h"
+#include "replay.h"
+#include "profiler.h"
+#include "allocTracker.h"
+#include "scenario.h"
+#include "skills.h"
+#include "raylib.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace BlockEater;
+
+// block_sim: runs the simulation without a window as fast as it can and
+// prints throughput. Either a scripted scenario (the player wanders in a
+// slow circle; a new run with the next seed starts when one ends) or a
+// recorded replay, checked tick by tick against its state hashes.
+// --scenario / --stress hold the population at a stress scenario's
+// counts (see scenario.h) for its duration instead of the spawn curve.
+// --no-alloc (needs BLOCK_TRACK_ALLOC) fails on the first tick past the
+// warm-up of a run that touches the heap, and names the call sites. The
+// warm-up doesn't prove a run will stay allocation-free: grid cells and
+// contact stripes are sized for typical densities, and a crowd packed
+// tighter later on still grows them (reported like any other allocation).
+
+namespace {
+
+const unsigned int NO_ALLOC_WARMUP_TICKS = 600;  // Lazily sized buffers reach their working size
+const int REPORTED_SITES = 8;
+
+struct Options {
+    int ticks = 18000;  // 5 minutes at 60 Hz
+    uint64_t seed = 1;
+    GameMode mode = GameMode::ENDLESS;
+    int level = 1;
+    int workers = -1;
+    int tickRate = DEFAULT_TICK_RATE;
+    const char* replayPath = nullptr;
+    const char* tracePath = nullptr;
+    const char* scenarioPath = nullptr;
+    int stressTotal = 0;  // --stress: built-in scenario of this many enemies
+    bool noAlloc = false;
+};
+
+struct Stats {
+    int ticks = 0;
+    int runs = 0;
+    double seconds = 0;
+    double worstTick = 0;
+    long long enemyTotal = 0;
+    int enemyMax = 0;
+    long long allocations = 0;
+    long long allocatedBytes = 0;
+    bool allocFailed = false;  // --no-alloc saw a steady-state allocation
+};
+
+double clockSeconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+void printUsage() {
+    printf("usage: block_sim [--ticks N] [--seed S] [--mode endless|level|time] [--level L]\n"
+           "                 [--workers W] [--tick-rate HZ] [--replay FILE] [--trace FILE]\n"
+           "                 [--scenario FILE | --stress ENEMIES] [--no-alloc] [--verbose]\n");
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--verbose") == 0) {
+            SetTraceLogLevel(LOG_INFO);
+            continue;
+        }
+        if (strcmp(arg, "--no-alloc") == 0) {
+            options.noAlloc = true;
+            continue;
+        }
+        if (!value) return false;
+        i++;
+        if (strcmp(arg, "--ticks") == 0) {
+            options.ticks = atoi(value);
+        } else if (strcmp(arg, "--seed") == 0) {
+            options.seed = strtoull(value, nullptr, 10);
+        } else if (strcmp(arg, "--mode") == 0) {
+            if (strcmp(value, "endless") == 0) options.mode = GameMode::ENDLESS;
+            else if (strcmp(value, "level") == 0) options.mode = GameMode::LEVEL;
+            else if (strcmp(value, "time") == 0) options.mode = GameMode::TIME_CHALLENGE;
+            else return false;
+        } else if (strcmp(arg, "--level") == 0) {
+            options.level = atoi(value);
+        } else if (strcmp(arg, "--workers") == 0) {
+            options.workers = atoi(value);
+        } else if (strcmp(arg, "--tick-rate") == 0) {
+            options.tickRate = atoi(value);
+        } else if (strcmp(arg, "--replay") == 0) {
+            options.replayPath = value;
+        } else if (strcmp(arg, "--trace") == 0) {
+            options.tracePath = value;
+        } else if (strcmp(arg, "--scenario") == 0) {
+            options.scenarioPath = value;
+        } else if (strcmp(arg, "--stress") == 0) {
+            options.stressTotal = atoi(value);
+            if (options.stressTotal <= 0) return false;
+        } else {
+            return false;
+        }
+    }
+    return options.ticks > 0 && options.tickRate > 0;
+}
+
+// zonesBefore: zone totals before the tick, to name the zones that allocated
+void reportAllocation(unsigned int tick, AllocCounts counts, const AllocCounts* zonesBefore) {
+    printf("tick %u of the run allocated %lld time(s), %lld bytes:\n", tick, counts.allocations, counts.bytes);
+    for (int z = 0; z < (int)ProfileZone::COUNT; z++) {
+        ProfileZone zone = (ProfileZone)z;
+        long long n = AllocTracker::getZone(zone).allocations - zonesBefore[z].allocations;
+        if (n > 0) printf("  in zone %s: %lld\n", Profiler::getZoneName(zone), n);
+    }
+    AllocSite sites[REPORTED_SITES];
+    int n = AllocTracker::getSites(sites, REPORTED_SITES);
+    for (int i = 0; i < n; i++) {
+        char name[256];
+        AllocTracker::describeSite(sites[i].address, name, sizeof(name));
+        printf("  %6lld x %8lld bytes  %s\n", sites[i].allocations, sites[i].bytes, name);
+    }
+}
+
+// One tick, timed
+void timedTick(Simulation& sim, float dt, Vector2 input, bool noAlloc, Stats& stats) {
+    bool steady = noAlloc && sim.getTickCount() >= NO_ALLOC_WARMUP_TICKS;
+    AllocCounts zonesBefore[(int)ProfileZone::COUNT];
+    if (steady) {
+        AllocTracker::resetSites();  // Only this tick's sites in a report
+        for (int z = 0; z < (int)ProfileZone::COUNT; z++) {
+            zonesBefore[z] = AllocTracker::getZone((ProfileZone)z);
+        }
+    }
+    AllocCounts before = AllocTracker::getTotal();
+    double start = clockSeconds();
+    sim.tick(dt, input);
+    double elapsed = clockSeconds() - start;
+    AllocCounts allocated = AllocTracker::getTotal() - before;
+    stats.allocations += allocated.allocations;
+    stats.allocatedBytes += allocated.bytes;
+    if (steady && allocated.allocations > 0 && !stats.allocFailed) {
+        stats.allocFailed = true;
+        reportAllocation(sim.getTickCount() - 1, allocated, zonesBefore);
+    }
+
+    sim.clearEvents();
+    stats.ticks++;
+    stats.seconds += elapsed;
+    if (elapsed > stats.worstTick) stats.worstTick = elapsed;
+    int enemies = sim.enemies->count();
+    stats.enemyTotal += enemies;
+    if (enemies > stats.enemyMax) stats.enemyMax = enemies;
+}
+
+void runScenario(Simulation& sim, const Options& options, Stats& stats) {
+    const float dt = 1.0f / options.tickRate;
+    uint64_t seed = options.seed;
+    sim.start(options.mode, options.level, seed);
+    stats.runs = 1;
+
+    while (stats.ticks < options.ticks && !stats.allocFailed) {
+        if (sim.isOver()) {
+            sim.start(options.mode, options.level, ++seed);
+            stats.runs++;
+        }
+        float t = sim.getGameTime();
+        Vector2 input = Replay::quantize({0.1f * cosf(t * 0.3f), 0.1f * sinf(t * 0.3f)});
+        timedTick(sim, dt, input, options.noAlloc, stats);
+    }
+}
+
+// One stress run, until the scenario's duration or --ticks runs out
+void runStress(Simulation& sim, const Scenario& scenario, const Options& options, Stats& stats) {
+    const float dt = 1.0f / options.tickRate;
+    sim.startScenario(scenario);
+    stats.runs = 1;
+
+    while (stats.ticks < options.ticks && !sim.isOver() && !stats.allocFailed) {
+        float t = sim.getGameTime();
+        Vector2 input = Replay::quantize({0.1f * cosf(t * 0.3f), 0.1f * sinf(t * 0.3f)});
+        timedTick(sim, dt, input, options.noAlloc, stats);
+    }
+}
+
+// Returns false if the run drifted from the recording
+bool runReplay(Simulation& sim, Replay& replay, bool noAlloc, Stats& stats) {
+    const float dt = 1.0f / replay.getTickRate();
+    sim.start((GameMode)replay.getMode(), replay.getLevel(), replay.getSeed());
+    stats.runs = 1;
+
+    for (unsigned int tick = 0; replay.hasTick(tick) && !stats.allocFailed; tick++) {
+        int skill;
+        while ((skill = replay.popSkill(tick)) >= 0) {
+            sim.activateSkill((SkillType)skill);
+        }
+        timedTick(sim, dt, replay.getMove(tick), noAlloc, stats);
+
+        unsigned int hash = sim.hashState();
+        if (hash != replay.getHash(tick)) {
+            printf("replay diverged at tick %u (state %08x, recorded %08x)\n",
+                   tick, hash, replay.getHash(tick));
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef BLOCK_PROFILE
+// min / avg / p99 of the sim zones over the last Profiler::HISTORY ticks,
+// and everything each zone allocated (with BLOCK_TRACK_ALLOC)
+void printProfile() {
+    printf("%-12s %8s %8s %8s %8s  (ms, last %d ticks)\n", "zone", "min", "avg", "p99", "allocs",
+           Profiler::HISTORY);
+    for (int z = 0; z <= (int)ProfileZone::PARTICLES; z++) {
+        ProfileZone zone = (ProfileZone)z;
+        ZoneStats stats = Profiler::getStats(zone);
+        printf("%-12s %8.3f %8.3f %8.3f %8lld\n", Profiler::getZoneName(zone), stats.minMs, stats.avgMs,
+               stats.p99Ms, AllocTracker::getZone(zone).allocations);
+    }
+}
+#endif
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    Replay replay;
+    if (options.replayPath && !replay.load(options.replayPath)) {
+        return 2;
+    }
+    Scenario scenario;
+    if (options.scenarioPath && !scenario.load(options.scenarioPath)) {
+        return 2;  // Scenario::load logged why
+    }
+    if (options.stressTotal > 0) {
+        scenario = Scenario::stress(options.stressTotal);
+    }
+    bool stress = options.scenarioPath || options.stressTotal > 0;
+    if (options.noAlloc && !AllocTracker::isEnabled()) {
+        printf("--no-alloc needs a build with BLOCK_TRACK_ALLOC\n");
+        return 2;
+    }
+
+    Simulation sim(options.workers);
+    Stats stats;
+    Profiler::setThreadName("sim");
+    if (options.tracePath) {
+        Profiler::startTrace();
+    }
+    bool matched = true;
+    if (options.replayPath) {
+        matched = runReplay(sim, replay, options.noAlloc, stats);
+    } else if (stress) {
+        printf("scenario %s: %d enemies, %.0f bullets/s, seed %llu\n", scenario.name,
+               scenario.getTotalPopulation(), scenario.bulletRate, (unsigned long long)scenario.seed);
+        runStress(sim, scenario, options, stats);
+    } else {
+        runScenario(sim, options, stats);
+    }
+
+    double seconds = stats.seconds > 0 ? stats.seconds : 1e-9;
+    printf("%d ticks in %.3f s: %.0f ticks/s, %.3f ms/tick avg, %.3f ms worst\n",
+           stats.ticks, stats.seconds, stats.ticks / seconds,
+           stats.seconds * 1000.0 / (stats.ticks > 0 ? stats.ticks : 1), stats.worstTick * 1000.0);
+    printf("%d run(s), enemies %.0f avg / %d max, %d worker thread(s)\n",
+           stats.runs, stats.ticks > 0 ? (double)stats.enemyTotal / stats.ticks : 0.0,
+           stats.enemyMax, sim.jobs->getWorkerCount());
+    if (AllocTracker::isEnabled()) {
+        printf("%.2f allocations / %.0f bytes per tick\n",
+               stats.ticks > 0 ? (double)stats.allocations / stats.ticks : 0.0,
+               stats.ticks > 0 ? (double)stats.allocatedBytes / stats.ticks : 0.0);
+    }
+#ifdef BLOCK_PROFILE
+    printProfile();
+#endif
+    if (options.tracePath && !Profiler::stopTrace(options.tracePath)) {
+        return 2;
+    }
+    if (options.replayPath) {
+        printf("replay %s\n", matched ? "matched every state hash" : "DIVERGED");
+    }
+    if (options.noAlloc) {
+        printf("no-alloc: %s\n", stats.allocFailed ? "FAILED" : "passed");
+    }
+    return (matched && !stats.allocFailed) ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+// Minimal float vector wrappers shared by the physics and collision kernels.
+// Picks NEON on arm64, AVX when the compiler targets it, SSE2 on x86-64,
+// and nothing (BLOCK_SIMD undefined) otherwise or with BLOCK_NO_SIMD.
+// Kernels check BLOCK_SIMD and always keep a scalar loop for the tail.
+
+#if !defined(BLOCK_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define BLOCK_SIMD_NEON 1
+#elif !defined(BLOCK_NO_SIMD) && defined(__AVX__)
+#include <immintrin.h>
+#define BLOCK_SIMD_AVX 1
+#elif !defined(BLOCK_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define BLOCK_SIMD_SSE2 1
+#endif
+
+#if defined(BLOCK_SIMD_NEON) || defined(BLOCK_SIMD_AVX) || defined(BLOCK_SIMD_SSE2)
+#define BLOCK_SIMD 1
+#endif
+
+namespace BlockEater {
+namespace simd {
+
+// A vector holds LANES floats; masks are all-ones lanes where true
+#if defined(BLOCK_SIMD_NEON)
+typedef float32x4_t VFloat;
+typedef uint32x4_t VMask;
+constexpr int LANES = 4;
+inline VFloat vload(const float* p) { return vld1q_f32(p); }
+inline void vstore(float* p, VFloat v) { vst1q_f32(p, v); }
+inline VFloat vset1(float s) { return vdupq_n_f32(s); }
+inline VFloat vadd(VFloat a, VFloat b) { return vaddq_f32(a, b); }
+inline VFloat vsub(VFloat a, VFloat b) { return vsubq_f32(a, b); }
+inline VFloat vmul(VFloat a, VFloat b) { return vmulq_f32(a, b); }
+inline VFloat vmin(VFloat a, VFloat b) { return vminq_f32(a, b); }
+inline VFloat vmax(VFloat a, VFloat b) { return vmaxq_f32(a, b); }
+inline VFloat vabs(VFloat a) { return vabsq_f32(a); }
+inline VFloat vneg(VFloat a) { return vnegq_f32(a); }
+inline VMask vlt(VFloat a, VFloat b) { return vcltq_f32(a, b); }
+inline VMask vgt(VFloat a, VFloat b) { return vcgtq_f32(a, b); }
+inline VMask vor(VMask a, VMask b) { return vorrq_u32(a, b); }
+inline VMask vand(VMask a, VMask b) { return vandq_u32(a, b); }
+// One bit per lane, lane 0 in bit 0
+inline int vmovemask(VMask m) {
+    const uint32_t weights[4] = {1, 2, 4, 8};
+    uint32x4_t bits = vandq_u32(m, vld1q_u32(weights));
+#if defined(__aarch64__)
+    return (int)vaddvq_u32(bits);
+#else
+    uint32x2_t sum = vpadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+    return (int)vget_lane_u32(vpadd_u32(sum, sum), 0);
+#endif
+}
+inline VFloat vselect(VMask m, VFloat a, VFloat b) { return vbslq_f32(m, a, b); }
+#elif defined(BLOCK_SIMD_AVX)
+typedef __m256 VFloat;
+typedef __m256 VMask;
+constexpr int LANES = 8;
+inline VFloat vload(const float* p) { return _mm256_loadu_ps(p); }
+inline void vstore(float* p, VFloat v) { _mm256_storeu_ps(p, v); }
+inline VFloat vset1(float s) { return _mm256_set1_ps(s); }
+inline VFloat vadd(VFloat a, VFloat b) { return _mm256_add_ps(a, b); }
+inline VFloat vsub(VFloat a, VFloat b) { return _mm256_sub_ps(a, b); }
+inline VFloat vmul(VFloat a, VFloat b) { return _mm256_mul_ps(a, b); }
+inline VFloat vmin(VFloat a, VFloat b) { return _mm256_min_ps(a, b); }
+inline VFloat vmax(VFloat a, VFloat b) { return _mm256_max_ps(a, b); }
+inline VFloat vabs(VFloat a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+inline VFloat vneg(VFloat a) { return _mm256_xor_ps(_mm256_set1_ps(-0.0f), a); }
+inline VMask vlt(VFloat a, VFloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+inline VMask vgt(VFloat a, VFloat b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+inline VMask vor(VMask a, VMask b) { return _mm256_or_ps(a, b); }
+inline VMask vand(VMask a, VMask b) { return _mm256_and_ps(a, b); }
+inline int vmovemask(VMask m) { return _mm256_movemask_ps(m); }
+inline VFloat vselect(VMask m, VFloat a, VFloat b) { return _mm256_blendv_ps(b, a, m); }
+#elif defined(BLOCK_SIMD_SSE2)
+typedef __m128 VFloat;
+typedef __m128 VMask;
+constexpr int LANES = 4;
+inline VFloat vload(const float* p) { return _mm_loadu_ps(p); }
+inline void vstore(float* p, VFloat v) { _mm_storeu_ps(p, v); }
+inline VFloat vset1(float s) { return _mm_set1_ps(s); }
+inline VFloat vadd(VFloat a, VFloat b) { return _mm_add_ps(a, b); }
+inline VFloat vsub(VFloat a, VFloat b) { return _mm_sub_ps(a, b); }
+inline VFloat vmul(VFloat a, VFloat b) { return _mm_mul_ps(a, b); }
+inline VFloat vmin(VFloat a, VFloat b) { return _mm_min_ps(a, b); }
+inline VFloat vmax(VFloat a, VFloat b) { return _mm_max_ps(a, b); }
+inline VFloat vabs(VFloat a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+inline VFloat vneg(VFloat a) { return _mm_xor_ps(_mm_set1_ps(-0.0f), a); }
+inline VMask vlt(VFloat a, VFloat b) { return _mm_cmplt_ps(a, b); }
+inline VMask vgt(VFloat a, VFloat b) { return _mm_cmpgt_ps(a, b); }
+inline VMask vor(VMask a, VMask b) { return _mm_or_ps(a, b); }
+inline VMask vand(VMask a, VMask b) { return _mm_and_ps(a, b); }
+inline int vmovemask(VMask m) { return _mm_movemask_ps(m); }
+inline VFloat vselect(VMask m, VFloat a, VFloat b) {
+    return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+}
+#endif
+
+} // namespace simd
+} // namespace BlockEater
+
+#endif // SIMD_H
@@ -0,0 +1,152 @@
+#include "integrator.h"
+#include "game.h"
+#include "random.h"
+#include "raylib.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace BlockEater;
+
+// block_simd_check: runs every physics kernel through the SIMD build and
+// through a second copy of integrator.cpp compiled with BLOCK_NO_SIMD, on
+// the same random bodies, and fails unless the results match bit for bit.
+// Replays and the lockstep checks assume a tick comes out the same whichever
+// path a body took, including the scalar tail of an odd-length column.
+
+// The scalar copy: integrator.cpp built with BlockEater renamed (CMakeLists.txt)
+namespace BlockEaterScalar {
+void integrateBodies(Vector2* pos, Vector2* vel, Vector2* acc, int count, float dt, float friction);
+void advanceBodies(Vector2* pos, Vector2* prev, const Vector2* vel, float* life, int count, float dt);
+void clampBodiesToWorld(Vector2* pos, Vector2* vel, const int* size, int count);
+void reflectBodiesOffWorld(Vector2* pos, Vector2* vel, const int* size, int count);
+const char* getSimdBackendName();
+}
+
+namespace {
+
+// Around every vector width, plus a long run
+const int BODY_COUNTS[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 33, 1001};
+const int ROUNDS = 20;          // Random inputs per count and kernel
+const float OUTSIDE = 200.0f;   // How far past the world bodies may start
+const float TICK_DT = 1.0f / 60.0f;
+const float FRICTION = 0.98f;
+
+struct Bodies {
+    std::vector<Vector2> pos, prev, vel, acc;
+    std::vector<float> life;
+    std::vector<int> size;
+};
+
+Bodies makeBodies(int count, Random& random) {
+    Bodies bodies;
+    bodies.pos.resize(count);
+    bodies.prev.resize(count);
+    bodies.vel.resize(count);
+    bodies.acc.resize(count);
+    bodies.life.resize(count);
+    bodies.size.resize(count);
+    for (int i = 0; i < count; i++) {
+        int size = 2 + random.nextInt(200);
+        bodies.size[i] = size;
+        bodies.pos[i] = {random.nextFloat(-OUTSIDE, WORLD_WIDTH + OUTSIDE),
+                         random.nextFloat(-OUTSIDE, WORLD_HEIGHT + OUTSIDE)};
+        // Some bodies sit exactly on a wall, where < and <= would disagree
+        switch (random.nextInt(8)) {
+            case 0: bodies.pos[i].x = (float)(size / 2); break;
+            case 1: bodies.pos[i].y = (float)(WORLD_HEIGHT - size / 2); break;
+            default: break;
+        }
+        bodies.prev[i] = {0, 0};
+        bodies.vel[i] = {random.nextFloat(-500, 500), random.nextFloat(-500, 500)};
+        bodies.acc[i] = {random.nextFloat(-2000, 2000), random.nextFloat(-2000, 2000)};
+        bodies.life[i] = random.nextFloat(0, 5);
+    }
+    return bodies;
+}
+
+template <typename T>
+bool sameBits(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+bool sameBodies(const Bodies& a, const Bodies& b) {
+    return sameBits(a.pos, b.pos) && sameBits(a.prev, b.prev) && sameBits(a.vel, b.vel) &&
+           sameBits(a.acc, b.acc) && sameBits(a.life, b.life);
+}
+
+void integrateSimd(Bodies& b) {
+    integrateBodies(b.pos.data(), b.vel.data(), b.acc.data(), (int)b.pos.size(), TICK_DT, FRICTION);
+}
+void integrateScalar(Bodies& b) {
+    BlockEaterScalar::integrateBodies(b.pos.data(), b.vel.data(), b.acc.data(), (int)b.pos.size(),
+                                      TICK_DT, FRICTION);
+}
+void advanceSimd(Bodies& b) {
+    advanceBodies(b.pos.data(), b.prev.data(), b.vel.data(), b.life.data(), (int)b.pos.size(), TICK_DT);
+}
+void advanceScalar(Bodies& b) {
+    BlockEaterScalar::advanceBodies(b.pos.data(), b.prev.data(), b.vel.data(), b.life.data(),
+                                    (int)b.pos.size(), TICK_DT);
+}
+void clampSimd(Bodies& b) {
+    clampBodiesToWorld(b.pos.data(), b.vel.data(), b.size.data(), (int)b.pos.size());
+}
+void clampScalar(Bodies& b) {
+    BlockEaterScalar::clampBodiesToWorld(b.pos.data(), b.vel.data(), b.size.data(), (int)b.pos.size());
+}
+void reflectSimd(Bodies& b) {
+    reflectBodiesOffWorld(b.pos.data(), b.vel.data(), b.size.data(), (int)b.pos.size());
+}
+void reflectScalar(Bodies& b) {
+    BlockEaterScalar::reflectBodiesOffWorld(b.pos.data(), b.vel.data(), b.size.data(), (int)b.pos.size());
+}
+
+struct Kernel {
+    const char* name;
+    void (*simd)(Bodies& bodies);
+    void (*scalar)(Bodies& bodies);
+};
+
+const Kernel KERNELS[] = {
+    {"integrateBodies", integrateSimd, integrateScalar},
+    {"advanceBodies", advanceSimd, advanceScalar},
+    {"clampBodiesToWorld", clampSimd, clampScalar},
+    {"reflectBodiesOffWorld", reflectSimd, reflectScalar},
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    uint64_t seed = argc > 1 ? strtoull(argv[1], nullptr, 10) : 1;
+    printf("block_simd_check: %s against %s, seed %llu\n", getSimdBackendName(),
+           BlockEaterScalar::getSimdBackendName(), (unsigned long long)seed);
+
+    int failures = 0;
+    for (const Kernel& kernel : KERNELS) {
+        Random random(seed, RandomStream::SIMD_CHECK);
+        int checked = 0;
+        for (int count : BODY_COUNTS) {
+            for (int round = 0; round < ROUNDS; round++) {
+                Bodies simd = makeBodies(count, random);
+                Bodies scalar = simd;
+                kernel.simd(simd);
+                kernel.scalar(scalar);
+                if (!sameBodies(simd, scalar)) {
+                    printf("  %s: mismatch at %d bodies, round %d\n", kernel.name, count, round);
+                    failures++;
+                }
+                checked++;
+            }
+        }
+        printf("  %-22s %d runs\n", kernel.name, checked);
+    }
+
+    if (failures > 0) {
+        printf("FAILED: %d mismatches\n", failures);
+        return 1;
+    }
+    printf("passed\n");
+    return 0;
+}
@@ -0,0 +1,782 @@
+#include "simulation.h"
+#include "player.h"
+#include "enemy.h"
+#include "bullet.h"
+#include "particles.h"
+#include "skills.h"
+#include "modes.h"
+#include "spatial.h"
+#include "entities.h"
+#include "collision.h"
+#include "jobs.h"
+#include "replay.h"
+#include "profiler.h"
+#include <cmath>
+
+namespace BlockEater {
+
+Simulation::Simulation(int workerCount)
+    : player(new Player())
+    , enemies(new EnemyStore())
+    , bullets(new BulletPool())
+    , particles(new ParticleSystem())
+    , skillManager(new SkillManager())
+    , modeManager(new GameModeManager())
+    , enemyGrid(new SpatialHash())
+    , bulletGrid(new BulletGrid())
+    , jobs(new JobSystem(workerCount))
+    , mode(GameMode::ENDLESS)
+    , score(0)
+    , timeRemaining(0)
+    , gameTime(0)
+    , tickCount(0)
+    , seed(0)
+    , over(false)
+    , scenarioActive(false)
+    , bulletBacklog(0)
+    , overlapBatch(new OverlapBatch())
+{
+    skillManager->init();
+    modeManager->init(mode);
+    // Per-tick buffers are sized for the spawn cap up front. Grid cells and
+    // contact stripes also depend on how tightly enemies pack: a crowd
+    // denser than they were sized for grows them once, to its high-water mark
+    reserveEnemies(MAX_ENEMIES);
+    bulletHits.reserve(BulletPool::CAPACITY);  // At most one hit per bullet
+    events.reserve(EVENT_RESERVE);
+}
+
+void Simulation::reserveEnemies(int count) {
+    enemies->reserve(count);  // Any mix of types
+    enemyGrid->reserve(count);
+    nearbyEnemies.reserve(count);
+    bulletEaters.reserve(count);
+    overlapBatch->reserve(count);
+    reserveEnemyContacts(count, contactStripes, enemyContacts);
+    int chunks = JobSystem::chunkCount(count, AI_GRAIN_SIZE);
+    if ((int)enemyCommands.size() < chunks) {
+        enemyCommands.resize(chunks);
+    }
+    for (auto& commands : enemyCommands) {
+        commands.shots.reserve(AI_GRAIN_SIZE);  // One shot and one eat per enemy and tick at most
+        commands.eats.reserve(AI_GRAIN_SIZE);
+    }
+}
+
+Simulation::~Simulation() {
+    clearEnemies();
+    delete player;
+    delete enemies;
+    delete bullets;
+    delete particles;
+    delete skillManager;
+    delete modeManager;
+    delete enemyGrid;
+    delete bulletGrid;
+    delete jobs;
+    delete overlapBatch;
+}
+
+void Simulation::start(GameMode newMode, int level, uint64_t newSeed) {
+    mode = newMode;
+    score = 0;
+    gameTime = 0;
+    tickCount = 0;
+    over = false;
+    scenarioActive = false;
+    bulletBacklog = 0;
+    events.clear();
+
+    // Initialize mode manager with new mode
+    modeManager->init(mode);
+
+    // Fresh player, skills and world
+    clear();
+    *skillManager = SkillManager();
+    skillManager->init();
+
+    // Every random stream of the run comes from the seed
+    seed = newSeed;
+    spawnRandom = Random(seed, RandomStream::SPAWN);
+    enemies->setSeed(seed);
+    particles->setSeed(seed);
+
+    // Set time based on mode
+    timeRemaining = 0;
+    if (mode == GameMode::TIME_CHALLENGE) {
+        timeRemaining = 180.0f;  // 3 minutes
+    } else if (mode == GameMode::LEVEL) {
+        // CRITICAL FIX: Load time limit from level definition
+        // Level time limits: 0=no limit, 120=2min, 180=3min, 240=4min, 300=5min
+        switch (level) {
+            case 1: timeRemaining = 0; break;     // No limit
+            case 2: timeRemaining = 0; break;     // No limit
+            case 3: timeRemaining = 120; break;   // 2 minutes
+            case 4: timeRemaining = 0; break;     // No limit
+            case 5: timeRemaining = 180; break;   // 3 minutes
+            case 6: timeRemaining = 0; break;     // No limit
+            case 7: timeRemaining = 240; break;   // 4 minutes
+            case 8: timeRemaining = 0; break;     // No limit
+            case 9: timeRemaining = 300; break;   // 5 minutes
+            case 10: timeRemaining = 180; break;  // 3 minutes
+            default: timeRemaining = 0; break;    // No limit
+        }
+    }
+}
+
+void Simulation::startScenario(const Scenario& newScenario) {
+    start(GameMode::ENDLESS, 1, newScenario.seed);
+    scenario = newScenario;
+    scenarioActive = true;
+
+    // Sized once here, so the run itself stays allocation-free
+    int total = scenario.getTotalPopulation();
+    reserveEnemies(total > MAX_ENEMIES ? total : MAX_ENEMIES);
+
+    // Full population from the first tick
+    spawnScenario(0);
+}
+
+void Simulation::clear() {
+    delete player;
+    player = new Player();
+    clearEnemies();
+    bullets->clear();
+}
+
+void Simulation::tick(float dt, Vector2 input) {
+    PROFILE_ZONE(ProfileZone::TICK);
+
+    // Remember where everything was, drawing blends toward the new positions
+    player->savePreviousPosition();
+    enemies->savePreviousPositions();
+
+    // Update player - physics-based movement
+    {
+        PROFILE_ZONE(ProfileZone::PLAYER);
+        player->applyJoystickInput(input);
+        player->update(dt, *bullets);
+    }
+
+    updateEnemies(dt);
+    updatePhysics(dt);
+    updateBullets(dt);
+
+    {
+        PROFILE_ZONE(ProfileZone::SKILLS);
+
+        // Update skill manager
+        skillManager->update(dt);
+
+        // Update mode manager (for level mode logic)
+        if (modeManager) {
+            modeManager->update(dt);
+        }
+
+        // Process shield interactions (convex reflection, concave acceleration)
+        skillManager->processShieldInteractions(player, *enemies);
+    }
+
+    // Check collisions
+    checkCollisions();
+
+    // Spawn enemies
+    spawnEnemies(dt);
+
+    // Update time remaining for time challenge mode
+    // For LEVEL mode, only check timeout if timeRemaining > 0 (has time limit)
+    if (mode == GameMode::TIME_CHALLENGE) {
+        timeRemaining -= dt;
+        if (timeRemaining <= 0) {
+            timeRemaining = 0;
+            over = true;
+            emit(SimEventType::DEATH);
+        }
+    } else if (mode == GameMode::LEVEL && timeRemaining > 0) {
+        // Only check timeout for levels that have a time limit
+        timeRemaining -= dt;
+        if (timeRemaining <= 0) {
+            timeRemaining = 0;
+            over = true;
+            emit(SimEventType::DEATH);
+        }
+    }
+
+    // Scenario runs end on time; an invulnerable player is healed instead of dying
+    if (scenarioActive) {
+        if (scenario.invulnerable) {
+            player->heal(player->getMaxHealth());
+        }
+        if (scenario.duration > 0 && gameTime + dt >= scenario.duration) {
+            over = true;
+        }
+    }
+
+    // Check game over
+    if (player->getHealth() <= 0) {
+        over = true;
+        emit(SimEventType::DEATH);
+    }
+
+    {
+        PROFILE_ZONE(ProfileZone::PARTICLES);
+        particles->update(dt);
+    }
+
+    // Update game time
+    gameTime += dt;
+    tickCount++;
+}
+
+void Simulation::updateEnemies(float dt) {
+    PROFILE_ZONE(ProfileZone::ENEMY_AI);
+
+    // Update enemy AI in parallel; shots and bullet eats go to per-chunk
+    // command buffers and are applied afterwards in chunk order. Enemies
+    // away from the screen update less often (see EnemyStore::assignLod)
+    bulletGrid->build(*bullets);
+    Vector2 playerPos = player->getPosition();
+    enemies->assignLod(playerPos);
+    int chunks = JobSystem::chunkCount(enemies->count(), AI_GRAIN_SIZE);
+    if ((int)enemyCommands.size() < chunks) {
+        enemyCommands.resize(chunks);
+    }
+    for (int c = 0; c < chunks; c++) {
+        enemyCommands[c].clear();
+    }
+    enemies->parallelForEach(*jobs, AI_GRAIN_SIZE, [&](Enemy* enemy, int chunk) {
+        enemy->simulate(tickCount, dt, playerPos, *bullets, *enemyGrid, *bulletGrid, enemyCommands[chunk]);
+    });
+    applyEnemyCommands(chunks);
+}
+
+void Simulation::updatePhysics(float dt) {
+    PROFILE_ZONE(ProfileZone::PHYSICS);
+
+    // Enemy physics runs over the store's columns
+    enemies->integrate(dt);
+    enemies->clampToWorld();
+
+    // Detect enemy contacts once per tick (broadphase + narrowphase, in
+    // parallel over stripes of grid rows)
+    syncEnemyGrid();
+    findEnemyContacts(*enemyGrid, *jobs, contactStripes, enemyContacts);
+
+    // Rigid body response between enemies
+    for (const Contact& contact : enemyContacts) {
+        Enemy* e1 = contact.a;
+        Enemy* e2 = contact.b;
+        e1->applyRigidBodyCollision(e2, contact.normal, contact.penetration);
+
+        // BOUNCING type special: deal damage and push away strongly
+        if (contact.pairClass == ContactClass::BOUNCING) {
+            if (e1->getType() == EnemyType::BOUNCING) {
+                e1->applyBouncingDamage(e2);
+            }
+            if (e2->getType() == EnemyType::BOUNCING) {
+                e2->applyBouncingDamage(e1);
+            }
+        }
+    }
+
+    // Resting STATIONARY enemies drop out of physics and the dynamic grid
+    enemies->updateSleep(dt, *enemyGrid);
+}
+
+void Simulation::updateBullets(float dt) {
+    PROFILE_ZONE(ProfileZone::BULLETS);
+
+    // Update bullets: move, expire and find hits in one pass (hits are applied in checkCollisions)
+    syncEnemyGrid();
+    bullets->update(dt, *enemyGrid, player->getPosition(), player->getSize() / 2.0f, bulletHits);
+}
+
+unsigned int Simulation::hashState() const {
+    StateHash hash;
+    hash.add(tickCount);
+    hash.add(player->getPosition());
+    hash.add(player->getVelocity());
+    hash.add(player->getSize());
+    hash.add(player->getHealth());
+    hash.add(player->getExperience());
+    hash.add(score);
+    hash.add(bullets->count());
+    enemies->forEach([&hash](Enemy* enemy) {
+        hash.add(enemy->getId());
+        hash.add(enemy->getPosition());
+        hash.add(enemy->getVelocity());
+        hash.add(enemy->getSize());
+        hash.add(enemy->getHealth());
+    });
+    return hash.get();
+}
+
+void Simulation::clearEnemies() {
+    // Grid first, it still points at the enemies
+    enemyGrid->clear();
+    enemies->clear();
+}
+
+void Simulation::applyEnemyCommands(int chunks) {
+    // Eats first: they name rows of the pool as it was during the AI pass.
+    // Two enemies may pick the same bullet, the earlier chunk gets it
+    for (int c = 0; c < chunks; c++) {
+        for (const auto& eat : enemyCommands[c].eats) {
+            if (bullets->isAlive(eat.bulletRow)) {
+                eat.enemy->eatBullet(*bullets, eat.bulletRow);
+            }
+        }
+    }
+    for (int c = 0; c < chunks; c++) {
+        for (const auto& shot : enemyCommands[c].shots) {
+            bullets->spawn(shot.position, shot.direction, shot.damage, -1);
+        }
+    }
+}
+
+void Simulation::syncEnemyGrid() {
+    enemies->syncGrid(*enemyGrid);
+}
+
+void Simulation::spawnEnemies(float dt) {
+    PROFILE_ZONE(ProfileZone::SPAWN);
+
+    if (scenarioActive) {
+        spawnScenario(dt);
+        return;
+    }
+
+    // Keep a minimum number of enemies - 4x spawn rate
+    int minEnemies = 80 + (int)(gameTime / 2.5f);  // 4x base, 4x faster increase
+    minEnemies = (minEnemies > MAX_ENEMIES) ? MAX_ENEMIES : minEnemies;  // Higher cap
+
+    if (enemies->count() < minEnemies) {
+        // Spawn multiple enemies at once - 4x spawn count
+        int spawnCount = 12 + (int)(gameTime / 15.0f);  // 4x spawn groups
+        if (spawnCount > 40) spawnCount = 40;
+        if (spawnCount > minEnemies - enemies->count()) spawnCount = minEnemies - enemies->count();
+
+        spawnEnemyGroup(spawnCount);
+    }
+}
+
+void Simulation::spawnEnemyGroup(int count) {
+    for (int i = 0; i < count; i++) {
+        // Use player position directly for spawning
+        Vector2 playerPos = player->getPosition();
+
+        // Spawn new enemy around player with safe distance
+        int side = spawnRandom.nextInt(4);
+        Vector2 pos;
+        float minSpawnDist = player->getSize() + 150.0f;  // Increased safe distance
+        float maxSpawnDist = minSpawnDist + 400.0f;     // Larger spawn area
+        float spawnDist = minSpawnDist + (float)spawnRandom.nextInt((int)(maxSpawnDist - minSpawnDist));
+
+        switch (side) {
+            case 0:  // Top
+                pos = {playerPos.x + (float)(spawnRandom.nextInt(400) - 200), playerPos.y - spawnDist};
+                break;
+            case 1:  // Bottom
+                pos = {playerPos.x + (float)(spawnRandom.nextInt(400) - 200), playerPos.y + spawnDist};
+                break;
+            case 2:  // Left
+                pos = {playerPos.x - spawnDist, playerPos.y + (float)(spawnRandom.nextInt(400) - 200)};
+                break;
+            case 3:  // Right
+                pos = {playerPos.x + spawnDist, playerPos.y + (float)(spawnRandom.nextInt(400) - 200)};
+                break;
+        }
+
+        // Clamp to world bounds
+        if (pos.x < 100) pos.x = 100;
+        if (pos.x > WORLD_WIDTH - 100) pos.x = (float)WORLD_WIDTH - 100;
+        if (pos.y < 100) pos.y = 100;
+        if (pos.y > WORLD_HEIGHT - 100) pos.y = (float)WORLD_HEIGHT - 100;
+
+        // Determine enemy type - all 4 types spawn randomly
+        EnemyType type = EnemyType::FLOATING;
+        int typeRoll = spawnRandom.nextInt(100);
+
+        // All 4 types have roughly equal chance (25% each)
+        if (typeRoll < 25) {
+            type = EnemyType::FLOATING;
+        } else if (typeRoll < 50) {
+            type = EnemyType::CHASING;
+        } else if (typeRoll < 75) {
+            type = EnemyType::STATIONARY;
+        } else {
+            type = EnemyType::BOUNCING;
+        }
+
+        // Determine size - mix of food pellets and dangerous enemies
+        int playerSize = player->getSize();
+        int minEnemySize, maxEnemySize;
+
+        if (typeRoll < 30) {
+            // Food pellets - smaller than player
+            minEnemySize = 10;
+            maxEnemySize = playerSize - 5;
+            if (maxEnemySize < 10) maxEnemySize = 10;
+        } else {
+            // Dangerous enemies - can be larger or smaller
+            minEnemySize = playerSize - 15;
+            maxEnemySize = playerSize + 40;
+            if (minEnemySize < 15) minEnemySize = 15;
+        }
+
+        int size = minEnemySize + spawnRandom.nextInt(maxEnemySize - minEnemySize);
+
+        Enemy* enemy = enemies->spawn(type, pos, size);
+        enemyGrid->insert(enemy);
+    }
+}
+
+void Simulation::spawnScenario(float dt) {
+    Vector2 playerPos = player->getPosition();
+    for (int t = 0; t < Scenario::TYPE_COUNT; t++) {
+        EnemyType type = (EnemyType)t;
+        int missing = scenario.population[t] - enemies->table(type).count();
+        for (int i = 0; i < missing; i++) {
+            // Anywhere in the world outside the clearance around the player
+            Vector2 pos;
+            do {
+                pos = {spawnRandom.nextFloat(100.0f, WORLD_WIDTH - 100.0f),
+                       spawnRandom.nextFloat(100.0f, WORLD_HEIGHT - 100.0f)};
+            } while (Vector2Length(pos - playerPos) < SCENARIO_CLEARANCE);
+
+            float u = powf(spawnRandom.nextFloat(), scenario.sizeBias);
+            int size = scenario.sizeMin + (int)(u * (scenario.sizeMax - scenario.sizeMin + 1));
+            if (size > scenario.sizeMax) size = scenario.sizeMax;
+
+            Enemy* enemy = enemies->spawn(type, pos, size);
+            enemyGrid->insert(enemy);
+        }
+    }
+
+    // Enemy fire from a ring around the player, aimed at it
+    bulletBacklog += scenario.bulletRate * dt;
+    while (bulletBacklog >= 1.0f) {
+        bulletBacklog -= 1.0f;
+        float angle = spawnRandom.nextFloat(0.0f, 2.0f * PI);
+        float distance = spawnRandom.nextFloat(SCENARIO_CLEARANCE, 2.0f * SCENARIO_CLEARANCE);
+        Vector2 dir = {cosf(angle), sinf(angle)};
+        Vector2 pos = {playerPos.x - dir.x * distance, playerPos.y - dir.y * distance};
+        bullets->spawn(pos, dir, scenario.bulletDamage, -1);  // Dropped when the pool is full
+    }
+}
+
+// Eating rules between the player and one enemy
+static void evaluateEating(int playerSize, const Enemy* enemy, bool& canPlayerEat, bool& canEnemyEat) {
+    int enemySize = enemy->getSize();
+
+    // Check if player can eat enemy
+    canPlayerEat = (playerSize > enemySize) || 
+                   ((enemy->getType() == EnemyType::CHASING || 
+                     enemy->getType() == EnemyType::FLOATING) && 
+                    enemy->isVulnerable());
+
+    // Check if enemy can eat player (only if enemy is significantly bigger)
+    canEnemyEat = (enemySize >= playerSize * 1.5f) && 
+                  (enemy->getType() != EnemyType::STATIONARY);
+}
+
+void Simulation::playerEatEnemy(Enemy* enemy) {
+    Vector2 enemyPos = enemy->getPosition();
+
+    // Grow by area
+    player->growByArea(enemy->getSize());
+
+    // Gain bullet skill if eating FLOATING enemy
+    if (enemy->getType() == EnemyType::FLOATING && !player->hasBulletSkill()) {
+        player->enableBulletSkill();
+        particles->spawnTextPopup(player->getPosition(), "BULLET SKILL!", {255, 255, 0, 255});
+    }
+
+    // Experience gain
+    int oldLevel = player->getLevel();
+    int expGained = enemy->getExpValue() * 2;
+    player->addExperience(expGained);
+    player->heal(5);
+    score += enemy->getExpValue() * 10;
+
+    // Check for level up
+    if (player->getLevel() > oldLevel) {
+        particles->spawnLevelUp(player->getPosition(), player->getLevel());
+        emit(SimEventType::LEVEL_UP);
+    }
+
+    // Check for level completion and unlock next level
+    if (mode == GameMode::LEVEL) {
+        LevelDefinition level = modeManager->getCurrentLevelDef();
+        int currentLevel = player->getLevel();
+
+        // Check if reached target score and level
+        if (score >= level.targetScore && currentLevel >= level.targetLevel) {
+            // Level complete! Unlock next level
+            if (currentLevel < 10) {
+                // Unlock next level
+                modeManager->nextLevel();
+                particles->spawnTextPopup(player->getPosition(),
+                    TextFormat("LEVEL %d COMPLETE!", currentLevel), {100, 255, 100, 255});
+                emit(SimEventType::LEVEL_UP);
+                emit(SimEventType::LEVEL_COMPLETE, currentLevel);  // Unlocked in the user's stats
+            }
+        }
+    }
+
+    emit(SimEventType::EAT, player->getLevel());
+
+    // Spawn particles
+    particles->spawnPixelExplosion(enemyPos, enemy->getColor(), 10);
+    particles->spawnTextPopup(enemyPos, "+SIZE", {100, 255, 100, 255});
+
+    enemy->kill();
+}
+
+// Upper bound on enemies a single blink can pass through
+static constexpr int MAX_BLINK_HITS = 16;
+
+void Simulation::activateSkill(SkillType skillType) {
+    if (!skillManager->canUseSkill(skillType)) return;
+
+    Vector2 facingDir = player->getFacingDirection();
+    int playerHP = player->getHealth();
+
+    if (skillType == SkillType::BLINK) {
+        // Handle blink - move player
+        Vector2 from = player->getPosition();
+        float blinkDist = player->getSize() * 5.0f;
+        Vector2 newPos = {
+            from.x + facingDir.x * blinkDist,
+            from.y + facingDir.y * blinkDist
+        };
+        // Clamp to world bounds
+        if (newPos.x < player->getSize()) newPos.x = player->getSize();
+        if (newPos.x > WORLD_WIDTH - player->getSize()) newPos.x = WORLD_WIDTH - player->getSize();
+        if (newPos.y < player->getSize()) newPos.y = player->getSize();
+        if (newPos.y > WORLD_HEIGHT - player->getSize()) newPos.y = WORLD_HEIGHT - player->getSize();
+
+        // Eat edible enemies along the blink path in the order they're passed;
+        // anything else is jumped over as before
+        syncEnemyGrid();
+        SweepHit hits[MAX_BLINK_HITS];
+        int hitCount = enemyGrid->querySegment(from, newPos, player->getSize() / 2.0f, nullptr,
+                                               hits, MAX_BLINK_HITS);
+        for (int i = 0; i < hitCount; i++) {
+            Enemy* enemy = hits[i].enemy;
+            if (!enemy->isAlive()) continue;
+
+            bool canPlayerEat, canEnemyEat;
+            evaluateEating(player->getSize(), enemy, canPlayerEat, canEnemyEat);
+            if (canPlayerEat && !canEnemyEat) {
+                playerEatEnemy(enemy);
+            }
+        }
+
+        player->setPosition(newPos);
+        player->resetInterpolation();  // Teleport, don't slide there
+        skillManager->useSkill(skillType, newPos, facingDir, player->getSize(), playerHP);
+        emit(SimEventType::BLINK);
+    } else if (skillType == SkillType::SHOOT) {
+        // Handle shoot - create bullet and consume HP
+        int hpCost = 20;
+        int currentHP = player->getHealth();
+        if (currentHP > hpCost) {
+            player->takeDamage(hpCost);
+            int damage = hpCost * 3;
+            bullets->spawn(player->getPosition(), facingDir, damage, 0);
+            skillManager->useSkill(skillType, player->getPosition(), facingDir, player->getSize(), currentHP);
+            emit(SimEventType::SHOOT);
+        }
+    } else if (skillType == SkillType::SHIELD) {
+        // Handle shield - set shield duration based on player level
+        int playerLevel = player->getLevel();
+        float shieldDuration = 1.0f + (playerLevel - 1) * 1.0f;  // 1-15 seconds
+        if (shieldDuration > 15.0f) shieldDuration = 15.0f;
+        skillManager->setShieldDuration(shieldDuration);
+        skillManager->useSkill(skillType, player->getPosition(), facingDir, player->getSize(), playerHP);
+        emit(SimEventType::SHIELD);
+    } else {
+        skillManager->useSkill(skillType, player->getPosition(), facingDir, player->getSize(), playerHP);
+        emit(SimEventType::ROTATE);
+    }
+}
+
+void Simulation::checkCollisions() {
+    PROFILE_ZONE(ProfileZone::COLLISIONS);
+
+    int playerSize = player->getSize();
+    Vector2 playerPos = player->getPosition();
+
+    // Positions changed since the pair pass (separation, shield push)
+    syncEnemyGrid();
+
+    // Apply the hits found by this tick's bullet pass
+    for (const BulletHit& hit : bulletHits) {
+        if (hit.enemy) {
+            // Player bullet hit enemy (damage already applied)
+            particles->spawnPixelExplosion(hit.point, {255, 255, 0, 255}, 5);
+            particles->spawnDamageNumber(hit.enemy->getPosition(), hit.damage, true);
+
+            if (hit.killed) {
+                score += hit.damage * 5;
+                player->addExperience(hit.damage / 2);
+            }
+        } else {
+            // Enemy bullet hit player
+            player->takeDamage(hit.damage);
+            particles->spawnPixelExplosion(hit.point, {255, 100, 100, 255}, 5);
+            particles->spawnDamageNumber(playerPos, hit.damage, false);
+            emit(SimEventType::HIT);
+        }
+    }
+    bulletHits.clear();
+
+    // Check shield-enemy collisions (shield blocks enemies)
+    if (skillManager->isShieldActive()) {
+        Vector2 shieldPos = skillManager->getShieldPosition();
+        Vector2 shieldDir = skillManager->getShieldDirection();
+        float shieldRadius = 80.0f;
+        float baseAngle = atan2f(shieldDir.y, shieldDir.x) * RAD2DEG;
+        
+        enemyGrid->queryRadius(shieldPos, shieldRadius, nearbyEnemies);
+        for (auto* enemy : nearbyEnemies) {
+            if (!enemy->isAlive()) continue;
+            
+            Vector2 enemyPos = enemy->getPosition();
+            int enemySize = enemy->getSize();
+            
+            // Calculate distance from enemy to shield center
+            float dist = Vector2Length(enemyPos - shieldPos);
+            float combinedRadius = shieldRadius + enemySize / 2.0f;
+            
+            if (dist < combinedRadius) {
+                // Calculate angle from shield center to enemy
+                float angleToEnemy = atan2f(enemyPos.y - shieldPos.y, enemyPos.x - shieldPos.x) * RAD2DEG;
+                
+                // Normalize angles to -180 to 180 range for comparison
+                float angleDiff = angleToEnemy - baseAngle;
+                while (angleDiff > 180) angleDiff -= 360;
+                while (angleDiff < -180) angleDiff += 360;
+                
+                // Check if enemy is within 45 degree shield arc (±22.5 degrees)
+                if (fabs(angleDiff) <= 22.5f) {
+                    // Enemy hit the shield - push it back
+                    Vector2 pushDir = Vector2Normalize(enemyPos - shieldPos);
+                    enemy->setPosition(shieldPos + pushDir * (shieldRadius + enemySize / 2.0f + 5.0f));
+                    
+                    // Deal damage to enemy (shield level * 10)
+                    int shieldDamage = skillManager->getShieldLevel() * 10;
+                    enemy->takeDamage(shieldDamage);
+                    
+                    // Spawn hit effect
+                    particles->spawnPixelExplosion(enemyPos, {100, 255, 100, 255}, 5);
+                    particles->spawnDamageNumber(enemyPos, shieldDamage, true);
+                    
+                    // Play shield hit sound
+                    emit(SimEventType::HIT);
+                }
+            }
+        }
+    }
+
+    // Check player-enemy collisions with rigid body physics
+    float playerHalf = playerSize / 2.0f;
+    Rectangle playerRect = {playerPos.x - playerHalf, playerPos.y - playerHalf, (float)playerSize, (float)playerSize};
+    enemyGrid->queryRect(playerRect, nearbyEnemies);
+
+    // AABB collision check, batched over all candidates (row i is nearbyEnemies[i])
+    overlapBatch->clear();
+    for (auto* enemy : nearbyEnemies) {
+        overlapBatch->add(playerPos, enemy->getPosition(), (playerSize + enemy->getSize()) / 2.0f);
+    }
+    testOverlaps(*overlapBatch);
+
+    for (int row : overlapBatch->hits) {
+        Enemy* enemy = nearbyEnemies[row];
+        if (!enemy->isAlive()) continue;
+
+        Vector2 enemyPos = enemy->getPosition();
+        int enemySize = enemy->getSize();
+
+        bool canPlayerEat, canEnemyEat;
+        evaluateEating(playerSize, enemy, canPlayerEat, canEnemyEat);
+        
+        if (canPlayerEat && !canEnemyEat) {
+            // Player eats enemy - grow by area
+            playerEatEnemy(enemy);
+        } else if (canEnemyEat) {
+            // Enemy eats player - game over
+            player->takeDamage(player->getHealth());  // Kill player
+            particles->spawnPixelExplosion(playerPos, {255, 0, 0, 255}, 20);
+            emit(SimEventType::DEATH);
+        } else {
+            // Rigid body collision - both survive but bounce off each other
+            Vector2 normal = Vector2Normalize(playerPos - enemyPos);
+            player->applyRigidBodyCollision(enemy->getMass(), enemy->getVelocity(), normal);
+            Vector2 negNormal = (Vector2){-normal.x, -normal.y};
+            enemy->applyRigidBodyCollision(player->getMass(), player->getVelocity(), negNormal);
+            
+            // Small damage on collision
+            int damage = enemySize / 5;
+            player->takeDamage(damage);
+            if (damage > 0) {
+                particles->spawnDamageNumber(playerPos, damage, false);
+            }
+        }
+    }
+    
+    // Enemy-enemy eating (consumes this tick's contact buffer)
+    for (const Contact& contact : enemyContacts) {
+        Enemy* e1 = contact.a;
+        Enemy* e2 = contact.b;
+        if (!e1->isAlive() || !e2->isAlive()) continue;
+
+        // BOUNCING types don't eat, they just deal damage (handled in physics response)
+        if (contact.pairClass == ContactClass::BOUNCING) continue;
+
+        Vector2 pos1 = e1->getPosition();
+        Vector2 pos2 = e2->getPosition();
+        int size1 = e1->getSize();
+        int size2 = e2->getSize();
+
+        // Check for vulnerable enemies (CHASING/FLOATING with <30% health)
+        bool e1Vulnerable = (e1->getType() == EnemyType::CHASING || e1->getType() == EnemyType::FLOATING) 
+                            && e1->isVulnerable();
+        bool e2Vulnerable = (e2->getType() == EnemyType::CHASING || e2->getType() == EnemyType::FLOATING) 
+                            && e2->isVulnerable();
+        
+        // Check if one can eat the other
+        if ((size1 > size2 || e2Vulnerable) && !(e1->getType() == EnemyType::STATIONARY && size1 < size2)) {
+            // e1 eats e2 (STATIONARY can eat if bigger, but not if smaller)
+            e1->growByArea(size2);
+            e2->takeDamage(e2->getHealth());
+            particles->spawnPixelExplosion(pos2, e2->getColor(), 8);
+            particles->spawnTextPopup(pos2, "EATEN", {255, 100, 100, 255});
+        } else if ((size2 > size1 || e1Vulnerable) && !(e2->getType() == EnemyType::STATIONARY && size2 < size1)) {
+            // e2 eats e1
+            e2->growByArea(size1);
+            e1->takeDamage(e1->getHealth());
+            particles->spawnPixelExplosion(pos1, e1->getColor(), 8);
+            particles->spawnTextPopup(pos1, "EATEN", {255, 100, 100, 255});
+        }
+        // If sizes are similar and neither is vulnerable, rigid body collision handles it
+    }
+    
+    // Process STATIONARY enemies eating bullets (eaten ones are compacted by the next bullet pass).
+    // Growing wakes a sleeping enemy, which swaps rows of the table, so walk
+    // a copy: every enemy gets exactly one try, in the same order every run
+    bulletGrid->build(*bullets);
+    const std::vector<Enemy*>& stationary = enemies->table(EnemyType::STATIONARY).owner;
+    bulletEaters.assign(stationary.begin(), stationary.end());
+    for (auto* enemy : bulletEaters) {
+        if (enemy->isAlive()) {
+            enemy->tryEatBullet(*bullets, *bulletGrid);
+        }
+    }
+
+    // Remove dead enemies (after the contact buffer is no longer used)
+    enemies->removeDead(*enemyGrid);
+}
+
+} // namespace BlockEater
@@ -0,0 +1,130 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "raylib.h"
+#include "game.h"
+#include "random.h"
+#include "scenario.h"
+#include <cstdint>
+#include <vector>
+
+namespace BlockEater {
+
+// Something the app should react to, raised by a tick. The simulation
+// never touches audio or user data itself, so it runs headless.
+enum class SimEventType {
+    EAT,             // value: player level (pitch)
+    LEVEL_UP,
+    DEATH,
+    HIT,
+    BLINK,
+    SHOOT,
+    SHIELD,
+    ROTATE,
+    LEVEL_COMPLETE,  // value: level just completed (unlocks the next)
+    QUICK_SAVE       // value: player level; raised by Game, not by ticks
+};
+
+struct SimEvent {
+    SimEventType type;
+    int value;
+    int score;   // QUICK_SAVE only: the run so far
+    float time;
+};
+
+// The game world and its fixed-step update: player, enemies, bullets,
+// skills, modes, collisions and spawning. Needs no window, GL or audio;
+// Game drives it from the sim thread, block_sim drives it directly.
+class Simulation {
+public:
+    static constexpr int MAX_ENEMIES = 400;  // Spawn cap of normal runs (scenarios set their own)
+    static constexpr float SCENARIO_CLEARANCE = 300.0f;  // Scenario enemies spawn no closer to the player
+
+    // workerCount as for JobSystem: -1 one per core, 0 runs inline
+    explicit Simulation(int workerCount = -1);
+    ~Simulation();
+
+    // New run: fresh player, no enemies or bullets, every random stream
+    // reseeded, so the same arguments and input replay the same run
+    void start(GameMode newMode, int level, uint64_t seed);
+    void clear();  // Drop the world without starting a run
+    // New ENDLESS run held at a stress scenario's populations instead of
+    // the spawn curve; ends after its duration
+    void startScenario(const Scenario& newScenario);
+
+    void tick(float dt, Vector2 input);
+    void activateSkill(SkillType skillType);  // Between ticks
+    unsigned int hashState() const;           // FNV-1a over the gameplay state
+
+    // The phases of tick() that dominate its cost. Public so block_bench
+    // can time them one at a time; the game only calls tick()
+    void updateEnemies(float dt);    // AI in parallel, then its commands
+    void updatePhysics(float dt);    // Integration, enemy contacts and response, sleep
+    void updateBullets(float dt);    // Move, expire and find hits
+    void checkCollisions();          // Applies bullet hits, shield, player and enemy eating
+    void spawnEnemyGroup(int count); // count enemies around the player, ignoring the cap
+
+    // Getters
+    bool isOver() const { return over; }
+    GameMode getMode() const { return mode; }
+    int getScore() const { return score; }
+    float getGameTime() const { return gameTime; }
+    float getTimeRemaining() const { return timeRemaining; }
+    unsigned int getTickCount() const { return tickCount; }
+    uint64_t getSeed() const { return seed; }
+    bool isScenario() const { return scenarioActive; }
+    const Scenario& getScenario() const { return scenario; }
+
+    // Events raised since the last clearEvents()
+    const std::vector<SimEvent>& getEvents() const { return events; }
+    void clearEvents() { events.clear(); }
+
+    // World
+    Player* player;
+    EnemyStore* enemies;  // Archetype tables, iterate with forEach/table
+    BulletPool* bullets;
+    ParticleSystem* particles;
+    SkillManager* skillManager;
+    GameModeManager* modeManager;
+    SpatialHash* enemyGrid;  // Broadphase for all enemy queries
+    BulletGrid* bulletGrid;  // Rebuilt each tick for bullet lookups
+    JobSystem* jobs;         // Worker pool for parallel sim passes
+
+private:
+    GameMode mode;
+    int score;
+    float timeRemaining;
+    float gameTime;          // Simulation clock, advanced per tick
+    unsigned int tickCount;  // Ticks simulated this run (enemy LOD cadence)
+    uint64_t seed;           // Seeds every random stream of the run
+    Random spawnRandom;
+    bool over;               // Set when the round ends
+    Scenario scenario;
+    bool scenarioActive;     // This run is scenario's stress run
+    float bulletBacklog;     // Scenario shots due but not fired yet
+    std::vector<SimEvent> events;
+
+    // Reused broadphase query buffers (avoid per-tick allocation)
+    std::vector<ContactStripe> contactStripes;  // Per-stripe scratch of the contact pass
+    std::vector<Contact> enemyContacts;  // Shared by physics response and eating
+    std::vector<Enemy*> nearbyEnemies;
+    std::vector<Enemy*> bulletEaters;  // STATIONARY rows at the start of bullet eating
+    std::vector<BulletHit> bulletHits;  // Filled by the bullet pass, applied in checkCollisions
+    OverlapBatch* overlapBatch;  // Packed candidates for the batched AABB test
+    std::vector<EnemyCommandBuffer> enemyCommands;  // One per AI chunk
+    static constexpr int AI_GRAIN_SIZE = 64;  // Enemies per AI job
+    static constexpr int EVENT_RESERVE = 256;  // Events a tick can raise before the list grows
+
+    void emit(SimEventType type, int value = 0) { events.push_back({type, value, 0, 0.0f}); }
+    void spawnEnemies(float dt);  // Tops the population up toward the time-based minimum
+    void spawnScenario(float dt);  // Tops every type up to its scenario population, fires its bullets
+    void reserveEnemies(int count);  // Per-tick buffers for count enemies
+    void syncEnemyGrid();
+    void applyEnemyCommands(int chunks);
+    void clearEnemies();
+    void playerEatEnemy(Enemy* enemy);  // Score, growth and effects for one eaten enemy
+};
+
+} // namespace BlockEater
+
+#endif // SIMULATION_H
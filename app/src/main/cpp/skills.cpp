@@ -1,5 +1,6 @@
 #include "skills.h"
 #include "enemy.h"
+#include "entities.h"
 #include "player.h"
 #include "game.h"
 #include <cstdio>
@@ -62,44 +63,6 @@ void SkillManager::update(float dt) {
     }
 }
 
-void SkillManager::draw() {
-    // Draw skill buttons in bottom-right corner
-    float buttonSize = 60.0f;
-    float startX = SCREEN_WIDTH - 280.0f;
-    float startY = SCREEN_HEIGHT - 80.0f;
-    float spacing = 70.0f;
-
-    for (int i = 0; i < 4; i++) {
-        float x = startX + i * spacing;
-        float y = startY;
-
-        // Draw button background
-        Color bgColor = skills[i].buttonColor;
-        if (!skills[i].isReady()) {
-            // Dim the button when on cooldown
-            bgColor = {(unsigned char)(bgColor.r / 3), (unsigned char)(bgColor.g / 3), (unsigned char)(bgColor.b / 3), 200};
-        }
-        DrawRectangle((int)x, (int)y, (int)buttonSize, (int)buttonSize, bgColor);
-        DrawRectangleLines((int)x, (int)y, (int)buttonSize, (int)buttonSize, WHITE);
-
-        // Draw skill icon (simple circle)
-        DrawCircle((int)(x + buttonSize/2), (int)(y + buttonSize/2), 15, {255, 255, 255, 200});
-
-        // Draw cooldown overlay
-        if (!skills[i].isReady()) {
-            float cooldownPercent = skills[i].currentCooldown / skills[i].cooldown;
-            int cooldownHeight = (int)(buttonSize * cooldownPercent);
-            DrawRectangle((int)x, (int)y, (int)buttonSize, cooldownHeight, {0, 0, 0, 150});
-        }
-
-        // Draw skill number
-        char numText[8];
-        sprintf(numText, "%d", i + 1);
-        int textWidth = MeasureText(numText, 20);
-        DrawText(numText, (int)(x + buttonSize - textWidth - 5), (int)(y + buttonSize - 25), 20, WHITE);
-    }
-}
-
 bool SkillManager::canUseSkill(SkillType type) const {
     int index = (int)type;
     if (index < 0 || index >= 4) return false;
@@ -251,7 +214,7 @@ bool SkillManager::checkShieldCollision(Vector2 entityPos, Vector2& entityVel, f
     }
 }
 
-void SkillManager::processShieldInteractions(Player* player, std::vector<Enemy*>& enemies) {
+void SkillManager::processShieldInteractions(Player* player, EnemyStore& enemies) {
     if (!isShieldActive() || !player) return;
     
     // Check collision with player
@@ -265,8 +228,8 @@ void SkillManager::processShieldInteractions(Player* player, std::vector<Enemy*>
     }
     
     // Check collision with enemies
-    for (auto* enemy : enemies) {
-        if (!enemy->isAlive()) continue;
+    enemies.forEach([&](Enemy* enemy) {
+        if (!enemy->isAlive()) return;
         
         Vector2 enemyVel = enemy->getVelocity();
         Vector2 enemyPos = enemy->getPosition();
@@ -281,7 +244,7 @@ void SkillManager::processShieldInteractions(Player* player, std::vector<Enemy*>
                 enemy->takeDamage(damage);
             }
         }
-    }
+    });
 }
 
 } // namespace BlockEater
@@ -60,7 +60,7 @@ public:
     //          false if it should pass through (concave side) with acceleration
     bool checkShieldCollision(Vector2 entityPos, Vector2& entityVel, float entityMass, 
                               bool& shouldAccelerate);
-    void processShieldInteractions(Player* player, std::vector<Enemy*>& enemies);
+    void processShieldInteractions(Player* player, EnemyStore& enemies);
 
     // Skill visual effects
     bool isRotating() const { return m_isRotating; }
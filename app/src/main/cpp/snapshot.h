@@ -0,0 +1,96 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "raylib.h"
+#include "game.h"
+#include "player.h"
+#include "enemy.h"
+#include "bullet.h"
+#include "skills.h"
+#include "particles.h"
+#include "simulation.h"
+#include "spsc.h"
+#include <atomic>
+#include <vector>
+
+namespace BlockEater {
+
+// Lock-free triple buffer: the writer fills its back buffer and publishes
+// it, the reader picks up the newest published buffer when it wants one.
+// Neither side waits; the reader skips snapshots it was too slow to see.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : back(0), ready(1), front(2) {}
+
+    // Writer side
+    T& write() { return buffers[back]; }
+    void publish() {
+        back = ready.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Reader side: swap in the newest buffer, false if nothing new
+    bool acquire() {
+        if (!(ready.load(std::memory_order_relaxed) & FRESH)) return false;
+        front = ready.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    T& read() { return buffers[front]; }
+
+protected:
+    T buffers[3];
+
+private:
+    static constexpr int INDEX = 3;
+    static constexpr int FRESH = 4;  // Set while the middle buffer is unread
+
+    int back;                // Owned by the writer
+    std::atomic<int> ready;  // Middle buffer index | FRESH
+    int front;               // Owned by the reader
+};
+
+// Everything drawPlaying needs from one simulation tick. The sim thread
+// fills it, the render thread only ever reads it, so drawing never
+// touches live simulation state. Enemies and bullets outside the view
+// the render thread last reported are left out (only counted).
+struct RenderSnapshot {
+    double tickTime;  // Sim clock at the end of the tick
+    float tickDt;
+    bool gameOver;
+
+    Player player;             // Copy, for drawing and the HUD
+    SkillManager skills;       // Effects and button cooldowns
+    ParticleSystem particles;
+    std::vector<EnemySprite> enemies;
+    std::vector<BulletSprite> bullets;
+    int enemiesCulled;
+    int bulletsCulled;
+
+    int score;
+    float timeRemaining;
+
+    RenderSnapshot()
+        : tickTime(0), tickDt(0), gameOver(false), enemiesCulled(0), bulletsCulled(0), score(0), timeRemaining(0) {}
+
+    // Room for every enemy and bullet in view, so capturing never grows
+    void reserve(int enemyCount) {
+        enemies.reserve(enemyCount);
+        bullets.reserve(BulletPool::CAPACITY);
+    }
+};
+
+class SnapshotBuffer : public TripleBuffer<RenderSnapshot> {
+public:
+    // Only while the sim thread is stopped
+    void reserve(int enemyCount) {
+        for (RenderSnapshot& snap : buffers) snap.reserve(enemyCount);
+    }
+};
+
+// Events raised by ticks, played back on the render thread
+constexpr size_t SIM_EVENT_CAPACITY = 256;
+class SimEventQueue : public SpscQueue<SimEvent, SIM_EVENT_CAPACITY> {};
+
+} // namespace BlockEater
+
+#endif // SNAPSHOT_H
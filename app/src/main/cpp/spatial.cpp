@@ -0,0 +1,460 @@
+#include "spatial.h"
+#include "enemy.h"
+#include "bullet.h"
+#include "collision.h"
+#include <algorithm>
+#include <cmath>
+
+namespace BlockEater {
+
+SpatialHash::SpatialHash()
+    : queryStamp(0)
+    , maxEnemySize(0)
+{
+    // Room for a typical crowd per cell up front, so enemies wandering
+    // into cells nobody used yet don't allocate mid-game. Nothing bounds a
+    // cell by the population: a tighter crowd grows it once, to its high-water mark
+    for (auto& layer : cells) {
+        layer.resize(GRID_COLS * GRID_ROWS);
+        for (auto& cell : layer) {
+            cell.reserve(CELL_RESERVE);
+        }
+    }
+}
+
+SpatialHash::~SpatialHash() {
+}
+
+void SpatialHash::clear() {
+    for (auto& layer : cells) {
+        for (auto& cell : layer) {
+            cell.clear();
+        }
+    }
+    for (auto& proxy : proxies) {
+        if (proxy.enemy) {
+            proxy.enemy->setGridProxy(-1);
+        }
+    }
+    proxies.clear();
+    freeProxies.clear();
+    queryStamp = 0;
+    maxEnemySize = 0;
+}
+
+int SpatialHash::cellCoord(float v, int maxCell) {
+    int c = (int)floorf(v / CELL_SIZE);
+    if (c < 0) c = 0;
+    if (c > maxCell) c = maxCell;
+    return c;
+}
+
+void SpatialHash::computeRange(const Enemy* enemy, int& minX, int& minY, int& maxX, int& maxY) const {
+    Vector2 pos = enemy->getPosition();
+    float half = enemy->getSize() / 2.0f;
+    minX = cellCoord(pos.x - half, GRID_COLS - 1);
+    minY = cellCoord(pos.y - half, GRID_ROWS - 1);
+    maxX = cellCoord(pos.x + half, GRID_COLS - 1);
+    maxY = cellCoord(pos.y + half, GRID_ROWS - 1);
+}
+
+void SpatialHash::addToCells(int proxyId) {
+    const Proxy& p = proxies[proxyId];
+    for (int cy = p.minY; cy <= p.maxY; cy++) {
+        for (int cx = p.minX; cx <= p.maxX; cx++) {
+            cells[p.layer][cy * GRID_COLS + cx].push_back(proxyId);
+        }
+    }
+}
+
+void SpatialHash::removeFromCells(int proxyId) {
+    const Proxy& p = proxies[proxyId];
+    for (int cy = p.minY; cy <= p.maxY; cy++) {
+        for (int cx = p.minX; cx <= p.maxX; cx++) {
+            std::vector<int>& cell = cells[p.layer][cy * GRID_COLS + cx];
+            for (size_t i = 0; i < cell.size(); i++) {
+                if (cell[i] == proxyId) {
+                    // Swap-remove, cell order does not matter
+                    cell[i] = cell.back();
+                    cell.pop_back();
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::reserve(int enemies) {
+    proxies.reserve(enemies);
+    freeProxies.reserve(enemies);
+}
+
+void SpatialHash::insert(Enemy* enemy) {
+    if (!enemy || enemy->getGridProxy() >= 0) return;
+
+    int proxyId;
+    if (!freeProxies.empty()) {
+        proxyId = freeProxies.back();
+        freeProxies.pop_back();
+    } else {
+        proxyId = (int)proxies.size();
+        proxies.push_back({});
+    }
+
+    if (enemy->getSize() > maxEnemySize) maxEnemySize = enemy->getSize();
+
+    Proxy& p = proxies[proxyId];
+    p.enemy = enemy;
+    p.queryStamp = 0;
+    p.layer = enemy->isAsleep() ? STATIC_LAYER : DYNAMIC_LAYER;
+    computeRange(enemy, p.minX, p.minY, p.maxX, p.maxY);
+    addToCells(proxyId);
+    enemy->setGridProxy(proxyId);
+}
+
+void SpatialHash::update(Enemy* enemy) {
+    int proxyId = enemy->getGridProxy();
+    if (proxyId < 0) return;
+
+    // Enemies grow by eating, keep the padding bound current
+    if (enemy->getSize() > maxEnemySize) maxEnemySize = enemy->getSize();
+
+    int minX, minY, maxX, maxY;
+    computeRange(enemy, minX, minY, maxX, maxY);
+
+    Proxy& p = proxies[proxyId];
+    int layer = enemy->isAsleep() ? STATIC_LAYER : DYNAMIC_LAYER;
+    if (layer == p.layer &&
+        minX == p.minX && minY == p.minY && maxX == p.maxX && maxY == p.maxY) {
+        return;  // Still covers the same cells
+    }
+
+    removeFromCells(proxyId);
+    p.layer = layer;
+    p.minX = minX;
+    p.minY = minY;
+    p.maxX = maxX;
+    p.maxY = maxY;
+    addToCells(proxyId);
+}
+
+void SpatialHash::remove(Enemy* enemy) {
+    int proxyId = enemy->getGridProxy();
+    if (proxyId < 0) return;
+
+    removeFromCells(proxyId);
+    proxies[proxyId].enemy = nullptr;
+    freeProxies.push_back(proxyId);
+    enemy->setGridProxy(-1);
+}
+
+void SpatialHash::queryPairs(std::vector<EnemyPair>& out) const {
+    queryPairs(0, GRID_ROWS, out);
+}
+
+void SpatialHash::queryPairs(int firstRow, int endRow, std::vector<EnemyPair>& out) const {
+    out.clear();
+
+    for (int cy = firstRow; cy < endRow; cy++) {
+        for (int cx = 0; cx < GRID_COLS; cx++) {
+            const std::vector<int>& cell = cells[DYNAMIC_LAYER][cy * GRID_COLS + cx];
+            const std::vector<int>& staticCell = cells[STATIC_LAYER][cy * GRID_COLS + cx];
+            for (size_t i = 0; i < cell.size(); i++) {
+                // Moving against moving
+                for (size_t j = i + 1; j < cell.size(); j++) {
+                    addPair(cell[i], cell[j], cx, cy, out);
+                }
+                // Moving against sleeping; sleeping pairs never move, so
+                // they're never tested against each other
+                for (int staticId : staticCell) {
+                    addPair(cell[i], staticId, cx, cy, out);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::addPair(int id1, int id2, int cx, int cy, std::vector<EnemyPair>& out) const {
+    const Proxy& p1 = proxies[id1];
+    const Proxy& p2 = proxies[id2];
+
+    // Pairs spanning several shared cells are only reported
+    // from the first shared cell (top-left of the overlap)
+    int firstX = p1.minX > p2.minX ? p1.minX : p2.minX;
+    int firstY = p1.minY > p2.minY ? p1.minY : p2.minY;
+    if (firstX != cx || firstY != cy) return;
+
+    // Order by enemy id so results are deterministic
+    if (p1.enemy->getId() < p2.enemy->getId()) {
+        out.push_back({p1.enemy, p2.enemy});
+    } else {
+        out.push_back({p2.enemy, p1.enemy});
+    }
+}
+
+unsigned int SpatialHash::nextQueryStamp() {
+    queryStamp++;
+    if (queryStamp == 0) {
+        // Stamp wrapped around, reset so stale stamps can't match
+        for (auto& proxy : proxies) proxy.queryStamp = 0;
+        queryStamp = 1;
+    }
+    return queryStamp;
+}
+
+void SpatialHash::queryRect(Rectangle area, std::vector<Enemy*>& out) {
+    out.clear();
+
+    unsigned int stamp = nextQueryStamp();
+
+    int minX = cellCoord(area.x, GRID_COLS - 1);
+    int minY = cellCoord(area.y, GRID_ROWS - 1);
+    int maxX = cellCoord(area.x + area.width, GRID_COLS - 1);
+    int maxY = cellCoord(area.y + area.height, GRID_ROWS - 1);
+
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            for (const auto& layer : cells) {
+                for (int proxyId : layer[cy * GRID_COLS + cx]) {
+                    Proxy& p = proxies[proxyId];
+                    if (p.queryStamp == stamp) continue;
+                    p.queryStamp = stamp;
+                    out.push_back(p.enemy);
+                }
+            }
+        }
+    }
+}
+
+void SpatialHash::queryRadius(Vector2 center, float radius, std::vector<Enemy*>& out) {
+    queryRect({center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f}, out);
+}
+
+int SpatialHash::queryNeighbors(Vector2 center, float radius, const Enemy* exclude,
+                                Enemy** out, int maxResults) const {
+    if (maxResults > MAX_NEIGHBORS) maxResults = MAX_NEIGHBORS;
+    if (maxResults <= 0) return 0;
+
+    float distSq[MAX_NEIGHBORS];
+    float radiusSq = radius * radius;
+    int count = 0;
+
+    int minX = cellCoord(center.x - radius, GRID_COLS - 1);
+    int minY = cellCoord(center.y - radius, GRID_ROWS - 1);
+    int maxX = cellCoord(center.x + radius, GRID_COLS - 1);
+    int maxY = cellCoord(center.y + radius, GRID_ROWS - 1);
+
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            for (const auto& layer : cells) {
+                for (int proxyId : layer[cy * GRID_COLS + cx]) {
+                    // A multi-cell entry is reported from the first cell both
+                    // ranges share (no query stamp, so nothing is written)
+                    const Proxy& p = proxies[proxyId];
+                    if (cx != (p.minX > minX ? p.minX : minX) ||
+                        cy != (p.minY > minY ? p.minY : minY)) continue;
+
+                    Enemy* enemy = p.enemy;
+                    if (enemy == exclude || !enemy->isAlive()) continue;
+
+                    Vector2 pos = enemy->getPreviousPosition();
+                    float dx = pos.x - center.x;
+                    float dy = pos.y - center.y;
+                    float d = dx * dx + dy * dy;
+                    if (d >= radiusSq) continue;
+
+                    // Full buffer: only keep it if closer than the current farthest
+                    if (count == maxResults) {
+                        if (d >= distSq[count - 1]) continue;
+                        count--;
+                    }
+
+                    // Insertion into the sorted buffer
+                    int i = count;
+                    while (i > 0 && distSq[i - 1] > d) {
+                        distSq[i] = distSq[i - 1];
+                        out[i] = out[i - 1];
+                        i--;
+                    }
+                    distSq[i] = d;
+                    out[i] = enemy;
+                    count++;
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+int SpatialHash::querySegment(Vector2 from, Vector2 to, float halfExtent, const Enemy* exclude,
+                              SweepHit* hits, int maxHits) {
+    if (maxHits > MAX_NEIGHBORS) maxHits = MAX_NEIGHBORS;
+    if (maxHits <= 0) return 0;
+
+    Vector2 delta = to - from;
+    float length = Vector2Length(delta);
+
+    // Sample the segment at most one cell apart; each sample covers the
+    // mover's box plus half a step so the samples cover the whole sweep
+    int steps = (int)(length / CELL_SIZE) + 1;
+    float pad = halfExtent + length / steps / 2.0f;
+
+    unsigned int stamp = nextQueryStamp();
+    int count = 0;
+
+    for (int step = 0; step <= steps; step++) {
+        float t = (float)step / steps;
+        Vector2 p = {from.x + delta.x * t, from.y + delta.y * t};
+
+        int minX = cellCoord(p.x - pad, GRID_COLS - 1);
+        int minY = cellCoord(p.y - pad, GRID_ROWS - 1);
+        int maxX = cellCoord(p.x + pad, GRID_COLS - 1);
+        int maxY = cellCoord(p.y + pad, GRID_ROWS - 1);
+
+        for (int cy = minY; cy <= maxY; cy++) {
+            for (int cx = minX; cx <= maxX; cx++) {
+                for (const auto& layer : cells) {
+                    for (int proxyId : layer[cy * GRID_COLS + cx]) {
+                        Proxy& proxy = proxies[proxyId];
+                        if (proxy.queryStamp == stamp) continue;
+                        proxy.queryStamp = stamp;
+
+                        Enemy* enemy = proxy.enemy;
+                        if (enemy == exclude || !enemy->isAlive()) continue;
+
+                        float toi;
+                        if (!sweepAABB(from, delta, halfExtent, enemy->getPosition(),
+                                       enemy->getSize() / 2.0f, toi)) {
+                            continue;
+                        }
+
+                        // Keep the earliest maxHits impacts, sorted by time
+                        if (count == maxHits) {
+                            if (toi >= hits[count - 1].time) continue;
+                            count--;
+                        }
+                        int i = count;
+                        while (i > 0 && hits[i - 1].time > toi) {
+                            hits[i] = hits[i - 1];
+                            i--;
+                        }
+                        hits[i] = {enemy, toi};
+                        count++;
+                    }
+                }
+            }
+        }
+    }
+
+    return count;
+}
+
+// Bullet grid
+BulletGrid::BulletGrid()
+    : cellStart(SpatialHash::GRID_COLS * SpatialHash::GRID_ROWS + 1, 0)
+    , padding(0)
+{
+    // Sized for a full pool up front, build() never allocates
+    sorted.reserve(BulletPool::CAPACITY);
+    bulletCells.reserve(BulletPool::CAPACITY);
+}
+
+BulletGrid::~BulletGrid() {
+}
+
+int BulletGrid::cellIndex(Vector2 pos) {
+    int cx = (int)floorf(pos.x / SpatialHash::CELL_SIZE);
+    int cy = (int)floorf(pos.y / SpatialHash::CELL_SIZE);
+    if (cx < 0) cx = 0;
+    if (cx > SpatialHash::GRID_COLS - 1) cx = SpatialHash::GRID_COLS - 1;
+    if (cy < 0) cy = 0;
+    if (cy > SpatialHash::GRID_ROWS - 1) cy = SpatialHash::GRID_ROWS - 1;
+    return cy * SpatialHash::GRID_COLS + cx;
+}
+
+void BulletGrid::build(const BulletPool& bullets) {
+    const int cellCount = SpatialHash::GRID_COLS * SpatialHash::GRID_ROWS;
+    const int bulletCount = bullets.count();
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    bulletCells.resize(bulletCount);
+    padding = 0;
+
+    // Count bullets per cell
+    int liveCount = 0;
+    for (int i = 0; i < bulletCount; i++) {
+        if (!bullets.isAlive(i)) {
+            bulletCells[i] = -1;
+            continue;
+        }
+        int cell = cellIndex(bullets.position[i]);
+        bulletCells[i] = cell;
+        cellStart[cell + 1]++;
+        liveCount++;
+
+        // Pad by size and travel so the whole swept segment is covered
+        float reach = BulletPool::SIZE / 2.0f +
+                      Vector2Length(bullets.position[i] - bullets.previousPosition[i]);
+        if (reach > padding) padding = reach;
+    }
+
+    // Prefix sum into start offsets
+    for (int c = 0; c < cellCount; c++) {
+        cellStart[c + 1] += cellStart[c];
+    }
+
+    // Scatter (stable, keeps row order within a cell)
+    sorted.resize(liveCount);
+    for (int i = 0; i < bulletCount; i++) {
+        int cell = bulletCells[i];
+        if (cell < 0) continue;
+        sorted[cellStart[cell]++] = i;
+    }
+
+    // Scatter advanced every start to the next cell's start, shift back
+    for (int c = cellCount; c > 0; c--) {
+        cellStart[c] = cellStart[c - 1];
+    }
+    cellStart[0] = 0;
+}
+
+void BulletGrid::cellRange(Rectangle area, int& minX, int& minY, int& maxX, int& maxY) const {
+    int minCell = cellIndex({area.x - padding, area.y - padding});
+    int maxCell = cellIndex({area.x + area.width + padding, area.y + area.height + padding});
+    minX = minCell % SpatialHash::GRID_COLS;
+    minY = minCell / SpatialHash::GRID_COLS;
+    maxX = maxCell % SpatialHash::GRID_COLS;
+    maxY = maxCell / SpatialHash::GRID_COLS;
+}
+
+void BulletGrid::queryRect(Rectangle area, std::vector<int>& out) const {
+    out.clear();
+
+    int minX, minY, maxX, maxY;
+    cellRange(area, minX, minY, maxX, maxY);
+
+    for (int cy = minY; cy <= maxY; cy++) {
+        int rowStart = cy * SpatialHash::GRID_COLS;
+        for (int i = cellStart[rowStart + minX]; i < cellStart[rowStart + maxX + 1]; i++) {
+            out.push_back(sorted[i]);
+        }
+    }
+}
+
+int BulletGrid::queryRect(Rectangle area, int* out, int maxResults) const {
+    int minX, minY, maxX, maxY;
+    cellRange(area, minX, minY, maxX, maxY);
+
+    int count = 0;
+    for (int cy = minY; cy <= maxY; cy++) {
+        // Cells of one row are contiguous in the sorted array
+        int rowStart = cy * SpatialHash::GRID_COLS;
+        for (int i = cellStart[rowStart + minX]; i < cellStart[rowStart + maxX + 1]; i++) {
+            if (count == maxResults) return count;
+            out[count++] = sorted[i];
+        }
+    }
+    return count;
+}
+
+} // namespace BlockEater
@@ -0,0 +1,133 @@
+#ifndef SPATIAL_H
+#define SPATIAL_H
+
+#include "raylib.h"
+#include "game.h"
+#include <vector>
+
+namespace BlockEater {
+
+class Enemy;
+class BulletPool;
+
+// Candidate pair produced by the broadphase (not yet overlap-tested)
+struct EnemyPair {
+    Enemy* a;
+    Enemy* b;
+};
+
+// Hit along a swept query, time is the fraction of the motion segment
+struct SweepHit {
+    Enemy* enemy;
+    float time;
+};
+
+// Uniform grid over the world used as collision broadphase.
+// Every enemy is registered in all cells its AABB covers. Moving an enemy only
+// touches the grid when its covered cell range changes, so per-frame updates
+// are O(1) for the common case of small moves.
+// Sleeping enemies sit in a separate static layer: queries see both layers,
+// but pairs are only formed with at least one moving enemy.
+class SpatialHash {
+public:
+    // Cell size tuned to typical enemy size (15-70 px)
+    static constexpr float CELL_SIZE = 64.0f;
+    static constexpr int GRID_COLS = (WORLD_WIDTH + 63) / 64;   // 80
+    static constexpr int GRID_ROWS = (WORLD_HEIGHT + 63) / 64;  // 45
+    static constexpr int MAX_NEIGHBORS = 32;  // Upper bound for neighbor queries
+
+    SpatialHash();
+    ~SpatialHash();
+
+    void clear();
+    void reserve(int enemies);  // Proxies for that many enemies without growing
+
+    // Registration (the proxy id is stored on the enemy)
+    void insert(Enemy* enemy);
+    void update(Enemy* enemy);  // Also moves it between layers on sleep/wake
+    void remove(Enemy* enemy);
+
+    // Each pair whose cell ranges overlap is reported exactly once, with
+    // the lower enemy id first (sleeping-sleeping pairs are skipped)
+    void queryPairs(std::vector<EnemyPair>& out) const;
+    // Only pairs whose first shared cell is in rows [firstRow, endRow), so
+    // disjoint row stripes can be queried in parallel without duplicates
+    void queryPairs(int firstRow, int endRow, std::vector<EnemyPair>& out) const;
+
+    // Enemies registered in any cell touched by the area (no duplicates)
+    void queryRect(Rectangle area, std::vector<Enemy*>& out);
+    void queryRadius(Vector2 center, float radius, std::vector<Enemy*>& out);
+
+    // Up to maxResults enemies whose center is within radius, nearest first.
+    // Writes into a caller-provided buffer and returns the count.
+    // Read-only and tested against positions at the start of the tick, so
+    // enemy AI may call it from several threads while enemies move.
+    int queryNeighbors(Vector2 center, float radius, const Enemy* exclude,
+                       Enemy** out, int maxResults) const;
+
+    // Enemies hit by a box of halfExtent moving from -> to, earliest first.
+    // Walks the cells along the segment and writes up to maxHits into the
+    // caller's buffer (maxHits = 1 gives just the first impact).
+    int querySegment(Vector2 from, Vector2 to, float halfExtent, const Enemy* exclude,
+                     SweepHit* hits, int maxHits);
+
+    // Largest enemy size registered since the last clear (for query padding)
+    int getMaxEnemySize() const { return maxEnemySize; }
+
+private:
+    static constexpr int DYNAMIC_LAYER = 0;
+    static constexpr int STATIC_LAYER = 1;  // Sleeping enemies
+    static constexpr int CELL_RESERVE = 16;  // Proxy ids per cell before it grows (see constructor)
+
+    struct Proxy {
+        Enemy* enemy;
+        int minX, minY, maxX, maxY;  // Covered cell range (inclusive)
+        unsigned int queryStamp;     // Dedupe for multi-cell entries
+        int layer;
+    };
+
+    std::vector<std::vector<int>> cells[2];  // Per layer, proxy ids per cell
+    std::vector<Proxy> proxies;
+    std::vector<int> freeProxies;
+    unsigned int queryStamp;
+    int maxEnemySize;
+
+    unsigned int nextQueryStamp();
+    static int cellCoord(float v, int maxCell);
+    void computeRange(const Enemy* enemy, int& minX, int& minY, int& maxX, int& maxY) const;
+    void addToCells(int proxyId);
+    void removeFromCells(int proxyId);
+    void addPair(int id1, int id2, int cx, int cy, std::vector<EnemyPair>& out) const;
+};
+
+// Bucketed grid for bullets, rebuilt every frame with a counting sort.
+// Bullets move several cells per frame and live briefly, so a full rebuild
+// is cheaper than incremental updates. Bullets are bucketed by center and
+// queries are padded by the largest half-size plus last-move distance, so
+// swept tests against the returned bullets can't miss one.
+class BulletGrid {
+public:
+    BulletGrid();
+    ~BulletGrid();
+
+    // Bucket all live bullets by pool row (rows stay valid until the
+    // pool's next update; bullets spawned after the build are not listed)
+    void build(const BulletPool& bullets);
+
+    // Rows of bullets whose AABB may touch the area (exact test is up to the caller)
+    void queryRect(Rectangle area, std::vector<int>& out) const;
+    int queryRect(Rectangle area, int* out, int maxResults) const;
+
+private:
+    std::vector<int> cellStart;      // Prefix offsets into sorted, one per cell + 1
+    std::vector<int> sorted;         // Bullet rows grouped by cell
+    std::vector<int> bulletCells;    // Scratch: cell of each bullet during build
+    float padding;
+
+    static int cellIndex(Vector2 pos);
+    void cellRange(Rectangle area, int& minX, int& minY, int& maxX, int& maxY) const;
+};
+
+} // namespace BlockEater
+
+#endif // SPATIAL_H
@@ -0,0 +1,55 @@
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace BlockEater {
+
+// Bounded single-producer single-consumer ring. One thread pushes, one
+// thread pops; neither blocks. Capacity must be a power of two, one slot
+// stays free to tell full from empty.
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // Producer side; false when the queue is full
+    bool push(const T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t next = (t + 1) & MASK;
+        if (next == head.load(std::memory_order_acquire)) return false;
+        items[t] = item;
+        tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: oldest item, without removing it
+    const T* peek() const {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return nullptr;
+        return &items[h];
+    }
+
+    // Consumer side; false when the queue is empty
+    bool pop(T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) return false;
+        item = items[h];
+        head.store((h + 1) & MASK, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    T items[Capacity];
+    alignas(64) std::atomic<size_t> head;  // Next slot to pop (consumer)
+    alignas(64) std::atomic<size_t> tail;  // Next slot to push (producer)
+};
+
+} // namespace BlockEater
+
+#endif // SPSC_H
@@ -1,6 +1,7 @@
 #include "ui.h"
 #include "player.h"
 #include "userManager.h"
+#include "profiler.h"
 #include <cstdio>
 #include <cmath>
 #include <cstring>
@@ -670,6 +671,21 @@ void UIManager::drawSettings() {
         settingsSelection = 3;  // View logs
     }
 
+#ifdef BLOCK_PROFILE
+    // Trace capture, written to Profiler::TRACE_FILE_PATH when stopped
+    const char* traceText = Profiler::isTracing() ? getText("Stop Trace", "停止追踪")
+                                                  : getText("Start Trace", "开始追踪");
+    if (drawButton(valueX + buttonWidth + 20, logsY, buttonWidth, buttonHeight, traceText)) {
+        settingsSelection = 5;  // Toggle trace capture
+    }
+
+    // Built-in stress runs (2k, 10k, 50k enemies), one per press
+    if (drawButton(valueX + 2 * (buttonWidth + 20), logsY, buttonWidth, buttonHeight,
+                   getText("Stress Test", "压力测试"))) {
+        settingsSelection = 6;
+    }
+#endif
+
     // Back button at bottom
     float backY = 520.0f;
     if (drawButton((float)(SCREEN_WIDTH / 2) - 100, backY, 200.0f, 50.0f,
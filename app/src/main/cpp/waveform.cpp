@@ -0,0 +1,69 @@
+#include "audio.h"
+#include <cmath>
+
+#ifndef PI
+#define PI 3.14159265358979323846f
+#endif
+
+// Sample math of the AudioGenerator. Kept apart from audio.cpp, which
+// needs raylib's audio module, so block_bench can link it on its own.
+
+namespace BlockEater {
+
+void AudioGenerator::GenerateWave(short* buffer, int size, int frequency, float duration,
+                                 WaveType type, float volume) {
+    int sampleRate = 44100;
+    int samples = (int)(sampleRate * duration);
+
+    for (int i = 0; i < size && i < samples; i++) {
+        float t = (float)i / sampleRate;
+        float sample = 0.0f;
+
+        switch (type) {
+            case WAVE_SINE:
+                sample = sinf(2.0f * PI * frequency * t);
+                break;
+            case WAVE_SQUARE:
+                sample = (sinf(2.0f * PI * frequency * t) > 0) ? 1.0f : -1.0f;
+                break;
+            case WAVE_SAWTOOTH:
+                sample = 2.0f * (t * frequency - floorf(0.5f + t * frequency));
+                break;
+            case WAVE_TRIANGLE:
+                sample = fabsf(2.0f * (t * frequency - floorf(0.5f + t * frequency))) - 1.0f;
+                break;
+        }
+
+        // Apply volume
+        sample *= volume * 0.3f;
+
+        // Convert to 16-bit
+        buffer[i] = (short)(sample * 32767.0f);
+    }
+}
+
+void AudioGenerator::ApplyEnvelope(short* buffer, int size, float attack, float decay,
+                                  float sustain, float release) {
+    int sampleRate = 44100;
+    int attackSamples = (int)(attack * sampleRate);
+    int decaySamples = (int)(decay * sampleRate);
+    int releaseSamples = (int)(release * sampleRate);
+
+    for (int i = 0; i < size; i++) {
+        float multiplier = 1.0f;
+
+        if (i < attackSamples) {
+            multiplier = (float)i / attackSamples;
+        } else if (i < attackSamples + decaySamples) {
+            float decayProgress = (float)(i - attackSamples) / decaySamples;
+            multiplier = 1.0f - (1.0f - sustain) * decayProgress;
+        } else if (i > size - releaseSamples) {
+            int releaseIndex = i - (size - releaseSamples);
+            multiplier = sustain * (1.0f - (float)releaseIndex / releaseSamples);
+        }
+
+        buffer[i] = (short)(buffer[i] * multiplier);
+    }
+}
+
+} // namespace BlockEater